@@ -0,0 +1,130 @@
+/**
+ * @file atlas_pack.cpp
+ * @brief 离线的图集打包工具。用 EasyX 逐个解码贴图，按高度从大到小逐行摆放（shelf packing），
+ *        把解码后的像素与索引一起写入一个图集文件（格式见 source/atlas.h）。游戏启动时只需映射这个文件，不再解码 PNG。
+ *        贴图改动后重新运行一次即可；图集不存在时游戏仍会逐个加载 PNG。
+ *
+ *        解码依赖 EasyX，因此只能在 Windows 上编译：在 Visual Studio 中新建控制台项目，添加本文件与 source/atlas.c，
+ *        把 source 加入包含目录。
+ *        用法（于 source 目录执行，生成游戏默认加载的图集）：
+ *            atlas_pack image\galaxy.atlas background=image\background.png player=image\player.png
+ *                enemy=image\enemy.png bullet=image\bullet.png
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <algorithm>
+#include <vector>
+#include <graphics.h>
+#include "atlas.h"
+
+#define ATLAS_PACK_MIN_WIDTH 256 // 图集的最小宽度，单位：像素
+
+static void usage() {
+	fprintf(stderr, "usage: atlas_pack output.atlas name=image.png [name=image.png ...]\n");
+}
+
+/**
+ * @brief 按高度从大到小在宽为 width 的图集中逐行摆放精灵，写入各精灵的坐标。
+ * @return 图集的高度。
+ */
+static int pack(std::vector<AtlasSprite>& sprites, const int width) {
+	std::vector<size_t> order(sprites.size());
+	for (size_t i = 0; i < order.size(); ++i) {
+		order[i] = i;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sprites[a].height > sprites[b].height; });
+
+	int x = 0, y = 0, shelf_height = 0;
+	for (const size_t i : order) {
+		if (x + sprites[i].width > width) {
+			x = 0;
+			y += shelf_height;
+			shelf_height = 0;
+		}
+		sprites[i].x = x;
+		sprites[i].y = y;
+		x += sprites[i].width;
+		shelf_height = std::max(shelf_height, sprites[i].height);
+	}
+	return y + shelf_height;
+}
+
+int wmain(int argc, wchar_t** argv) {
+	if (argc < 3 || (size_t)argc - 2 > ATLAS_MAX_SPRITES) {
+		usage();
+		return EXIT_FAILURE;
+	}
+
+	const size_t count = (size_t)argc - 2;
+	std::vector<IMAGE> images(count);
+	std::vector<AtlasSprite> sprites(count);
+	int width = ATLAS_PACK_MIN_WIDTH;
+
+	for (size_t i = 0; i < count; ++i) {
+		wchar_t* arg = argv[i + 2];
+		wchar_t* separator = wcschr(arg, L'=');
+		if (separator == NULL || separator == arg || (size_t)(separator - arg) >= ATLAS_NAME_SIZE) {
+			usage();
+			return EXIT_FAILURE;
+		}
+
+		// 精灵名称只允许 ASCII，直接逐字符转换。
+		AtlasSprite* sprite = &sprites[i];
+		memset(sprite->name, 0, sizeof(sprite->name));
+		for (wchar_t* c = arg; c < separator; ++c) {
+			if (*c > 0x7F) {
+				fprintf(stderr, "Sprite names must be ASCII.\n");
+				return EXIT_FAILURE;
+			}
+			sprite->name[c - arg] = (char)*c;
+		}
+
+		const wchar_t* path = separator + 1;
+		if (loadimage(&images[i], path) != 0) {
+			fwprintf(stderr, L"Failed to load %ls.\n", path);
+			return EXIT_FAILURE;
+		}
+		sprite->width = images[i].getwidth();
+		sprite->height = images[i].getheight();
+		width = std::max(width, sprite->width);
+	}
+
+	const int height = pack(sprites, width);
+	if (width > ATLAS_MAX_SIZE || height > ATLAS_MAX_SIZE) {
+		fprintf(stderr, "Atlas is too large: %d x %d.\n", width, height);
+		return EXIT_FAILURE;
+	}
+
+	size_t pixel_offset;
+	std::vector<unsigned char> data(atlas_file_size(width, height, count, &pixel_offset));
+	atlas_write_index(data.data(), width, height, sprites.data(), count);
+
+	DWORD* pixels = (DWORD*)(data.data() + pixel_offset);
+	for (size_t i = 0; i < count; ++i) {
+		const DWORD* src = GetImageBuffer(&images[i]);
+		for (int row = 0; row < sprites[i].height; ++row) {
+			memcpy(pixels + (size_t)(sprites[i].y + row) * width + sprites[i].x, src + (size_t)row * sprites[i].width, sizeof(DWORD) * sprites[i].width);
+		}
+	}
+
+	FILE* file = NULL;
+	if (_wfopen_s(&file, argv[1], L"wb") != 0 || file == NULL) {
+		fwprintf(stderr, L"Failed to open %ls.\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	const bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+	fclose(file);
+	if (!ok) {
+		fwprintf(stderr, L"Failed to write %ls.\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	printf("{\"width\": %d, \"height\": %d, \"sprites\": %zu, \"bytes\": %zu}\n", width, height, count, data.size());
+	return EXIT_SUCCESS;
+}
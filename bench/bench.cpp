@@ -0,0 +1,421 @@
+/**
+ * @file bench.cpp
+ * @brief 无窗口的 tick 吞吐量基准测试。按脚本驱动模拟核心运行若干场景，以 JSON 格式输出每 tick 耗时、每 tick 内存分配次数
+ *        以及 tick 耗时的 p50 / p99 / 最大值。
+ *        每个场景既可以用当前的模拟核心（world）运行，也可以用重写自 v1.0 的「链表 + object_collision」实现（baseline）运行，便于对比。
+ *
+ *        在 Linux 上编译（于仓库根目录执行）：
+ *            gcc -std=c11 -O2 -c source/world.c source/arena.c source/difficulty.c source/pool.c source/grid.c source/collision.c source/object.c \
+ *                source/control.c source/list.c source/timer.c source/rng.c
+ *            g++ -std=c++17 -O2 -Isource bench/bench.cpp source/log.cpp source/jobs.cpp source/profiler.cpp *.o -o galaxy_bench -lpthread
+ *        用法：
+ *            ./galaxy_bench [--scenario 名称] [--engine world|baseline|both] [--ticks N] [--threads N] [--log]
+ *        --threads 指定模拟核心使用的线程数，默认为 1（串行），为 0 时使用所有 CPU 核心。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include "world.h"
+#include "list.h"
+#include "log.h"
+#include "jobs.h"
+
+ // 统计内存分配次数：在 glibc 下替换 malloc 系列函数，转发给 glibc 的内部实现。其他平台上不统计，输出 -1。
+static std::atomic<unsigned long long> g_allocation_count(0);
+
+#if defined(__GLIBC__)
+#define BENCH_COUNT_ALLOCATIONS 1
+extern "C" {
+	void* __libc_malloc(size_t size);
+	void* __libc_calloc(size_t count, size_t size);
+	void* __libc_realloc(void* pointer, size_t size);
+
+	void* malloc(size_t size) {
+		g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+		return __libc_malloc(size);
+	}
+
+	void* calloc(size_t count, size_t size) {
+		g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+		return __libc_calloc(count, size);
+	}
+
+	void* realloc(void* pointer, size_t size) {
+		g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+		return __libc_realloc(pointer, size);
+	}
+}
+#else
+#define BENCH_COUNT_ALLOCATIONS 0
+#endif
+
+/**
+ * @brief 一个基准测试场景。
+ */
+typedef struct Scenario {
+	const char* name;
+	int difficulty;
+	int ticks;
+	size_t live_bullets; // 每个 tick 开始前把子弹补充到这个数量，0 表示只有玩家发射的子弹
+	double min_enemy_spawn_gap; // 负数表示使用难度的默认值
+} Scenario;
+
+static const Scenario g_scenarios[] = {
+	{ "easy", 0, 20000, 0, -1 },
+	{ "normal", 1, 20000, 0, -1 },
+	{ "hard", 2, 20000, 0, -1 },
+	{ "bullets_1k", 1, 5000, 1000, -1 },
+	{ "bullets_10k", 1, 1000, 10000, -1 },
+	{ "bullets_100k", 1, 200, 100000, -1 },
+	{ "spawn_storm", 2, 20000, 0, 0.0 },
+	{ "spawn_storm_bullets_10k", 2, 1000, 10000, 0.0 },
+};
+
+/**
+ * @brief 脚本化的输入：一直开火，同时左右往返移动。
+ */
+static unsigned scripted_input(const unsigned long long tick) {
+	return INPUT_FIRE | ((tick / 45) % 2 ? INPUT_LEFT : INPUT_RIGHT);
+}
+
+/**
+ * @brief 用于补充子弹的简单线性同余随机数，与 rand() 分开，避免影响敌机生成。
+ */
+static unsigned bench_random(unsigned* state) {
+	*state = *state * 1664525u + 1013904223u;
+	return *state >> 8;
+}
+
+static FILE* g_null_sink = NULL; // --log 时日志写入的空设备
+
+// ---------------------------------------------------------------------------
+// baseline：v1.0 的链表实现，逻辑与当时 main.cpp 中的 object_update() 相同。
+// ---------------------------------------------------------------------------
+
+typedef struct BaselineWorld {
+	Object player;
+	List* enemy_list, * bullet_list;
+	WorldParams params;
+	GameControlData* control;
+	unsigned long long tick, last_bullet_spawn_tick, last_enemy_spawn_tick;
+	bool log;
+} BaselineWorld;
+
+static void baseline_log(const BaselineWorld* world, const char* message) {
+	if (world->log) {
+		fprintf(g_null_sink, "%s\n", message);
+	}
+}
+
+static void baseline_append(List* list, const int x, const int y, const ObjectType type) {
+	Object* object = (Object*)malloc(sizeof(Object));
+	if (!object) {
+		fprintf(stderr, "malloc() failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	object->x = object->prev_x = x;
+	object->y = object->prev_y = y;
+	object->type = type;
+	list_append(list, object);
+}
+
+static size_t baseline_count(const List* list) {
+	size_t count = 0;
+	for (Node* node = list->head->next; node; node = node->next) {
+		++count;
+	}
+	return count;
+}
+
+static void baseline_step(BaselineWorld* world, const unsigned input) {
+	++world->tick;
+
+	Object* player = &world->player;
+	if (input & INPUT_UP) player->y -= world->params.player_speed;
+	if (input & INPUT_DOWN) player->y += world->params.player_speed;
+	if (input & INPUT_LEFT) player->x -= world->params.player_speed;
+	if (input & INPUT_RIGHT) player->x += world->params.player_speed;
+	if (player->y < 0) player->y = 0;
+	if (player->y + PLAYER_HEIGHT > SCREEN_HEIGHT) player->y = SCREEN_HEIGHT - PLAYER_HEIGHT;
+	if (player->x < 0) player->x = 0;
+	if (player->x + PLAYER_WIDTH > SCREEN_WIDTH) player->x = SCREEN_WIDTH - PLAYER_WIDTH;
+
+	const unsigned long long fire_gap = (unsigned long long)(world->params.min_fire_gap * WORLD_TICK_RATE + 0.5);
+	if ((input & INPUT_FIRE) && world->tick - world->last_bullet_spawn_tick >= fire_gap) {
+		baseline_append(world->bullet_list, player->x + PLAYER_WIDTH / 2 - BULLET_WIDTH / 2, player->y, BULLET);
+		world->last_bullet_spawn_tick = world->tick;
+		baseline_log(world, "A bullet has been fired.");
+	}
+
+	const unsigned long long spawn_gap = (unsigned long long)(world->params.min_enemy_spawn_gap * WORLD_TICK_RATE + 0.5);
+	if (world->tick - world->last_enemy_spawn_tick >= spawn_gap) {
+		baseline_append(world->enemy_list, rand() % (SCREEN_WIDTH - ENEMY_WIDTH), -ENEMY_HEIGHT, ENEMY);
+		world->last_enemy_spawn_tick = world->tick;
+		baseline_log(world, "An enemy has been spawned.");
+	}
+
+	for (Node* node = world->enemy_list->head->next; node; ) {
+		Node* next = node->next;
+		Object* enemy = (Object*)node->data;
+		enemy->y += world->params.enemy_speed;
+		if (enemy->y > SCREEN_HEIGHT) {
+			list_random_erase(world->enemy_list, node);
+			baseline_log(world, "An enemy has been erased. (out of bound)");
+		}
+		node = next;
+	}
+
+	for (Node* node = world->bullet_list->head->next; node; ) {
+		Node* next = node->next;
+		Object* bullet = (Object*)node->data;
+		bullet->y -= world->params.bullet_speed;
+		if (bullet->y < -BULLET_HEIGHT) {
+			list_random_erase(world->bullet_list, node);
+			baseline_log(world, "A bullet has been erased. (out of bound)");
+		}
+		node = next;
+	}
+
+	for (Node* enemy_node = world->enemy_list->head->next; enemy_node; ) {
+		Node* next_enemy_node = enemy_node->next;
+		for (Node* bullet_node = world->bullet_list->head->next; bullet_node; bullet_node = bullet_node->next) {
+			if (object_collision((Object*)enemy_node->data, (Object*)bullet_node->data)) {
+				list_random_erase(world->enemy_list, enemy_node);
+				list_random_erase(world->bullet_list, bullet_node);
+				baseline_log(world, "A bullet has been erased. (collision with enemy)");
+				baseline_log(world, "An enemy has been erased. (collision with bullet)");
+				game_control_add_score(world->control, POINTS_PER_HIT);
+				break;
+			}
+		}
+		enemy_node = next_enemy_node;
+	}
+
+	for (Node* enemy_node = world->enemy_list->head->next; enemy_node; ) {
+		Node* next_enemy_node = enemy_node->next;
+		if (object_collision((Object*)enemy_node->data, player)) {
+			list_random_erase(world->enemy_list, enemy_node);
+			baseline_log(world, "An enemy has been erased. (collision with player)");
+			game_control_reduce_hp(world->control, world->params.delta_hp);
+		}
+		enemy_node = next_enemy_node;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// 场景运行与结果统计
+// ---------------------------------------------------------------------------
+
+typedef struct BenchResult {
+	double ns_per_tick;
+	double allocations_per_tick;
+	double p50_ns, p99_ns, max_ns;
+	size_t final_enemies, final_bullets;
+	int score;
+} BenchResult;
+
+static double percentile(std::vector<double>& samples, const double p) {
+	if (samples.empty()) {
+		return 0;
+	}
+	const size_t index = std::min(samples.size() - 1, (size_t)(p * (samples.size() - 1) + 0.5));
+	std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+	return samples[index];
+}
+
+/**
+ * @brief 统计每 tick 耗时的分布。补充子弹的时间不计入 tick 耗时，但其内存分配会被计入，因此 world 引擎下补充子弹不分配内存。
+ */
+static void summarize(std::vector<double>& samples, const unsigned long long allocations, BenchResult* result) {
+	double total = 0, max = 0;
+	for (double sample : samples) {
+		total += sample;
+		max = std::max(max, sample);
+	}
+
+	result->ns_per_tick = samples.empty() ? 0 : total / samples.size();
+	result->allocations_per_tick = BENCH_COUNT_ALLOCATIONS && !samples.empty() ? (double)allocations / samples.size() : -1;
+	result->max_ns = max;
+	result->p50_ns = percentile(samples, 0.50);
+	result->p99_ns = percentile(samples, 0.99);
+}
+
+static WorldParams scenario_params(const Scenario* scenario) {
+	WorldParams params = world_default_params(scenario->difficulty);
+	if (scenario->min_enemy_spawn_gap >= 0) {
+		params.min_enemy_spawn_gap = scenario->min_enemy_spawn_gap;
+	}
+	params.capacity[BULLET] = std::max(params.capacity[BULLET], scenario->live_bullets + 1024);
+	return params;
+}
+
+static GameControlData scenario_control() {
+	GameControlData control = { MENU, 0, 0, true };
+	game_control_start(&control, 1 << 30); // 生命值足够多，保证场景不会提前结束。
+	return control;
+}
+
+static BenchResult run_world(const Scenario* scenario, const int ticks) {
+	unsigned refill_seed = 1;
+	GameControlData control = scenario_control();
+	const WorldParams params = scenario_params(scenario);
+	GameWorld world;
+	world_init_with_params(&world, &control, scenario->difficulty, &params, 1);
+
+	std::vector<double> samples;
+	samples.reserve(ticks);
+	const unsigned long long allocations_before = g_allocation_count.load();
+
+	for (int t = 0; t < ticks; ++t) {
+		while (world.pools[BULLET].count < scenario->live_bullets) {
+			world_spawn_bullet(&world, bench_random(&refill_seed) % (SCREEN_WIDTH - BULLET_WIDTH), bench_random(&refill_seed) % SCREEN_HEIGHT);
+		}
+
+		const auto begin = std::chrono::steady_clock::now();
+		world_step(&world, scripted_input(world.tick));
+		const auto end = std::chrono::steady_clock::now();
+		samples.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+	}
+
+	BenchResult result;
+	summarize(samples, g_allocation_count.load() - allocations_before, &result);
+	result.final_enemies = world.pools[ENEMY].count;
+	result.final_bullets = world.pools[BULLET].count;
+	result.score = control.score;
+	world_free(&world);
+	return result;
+}
+
+static BenchResult run_baseline(const Scenario* scenario, const int ticks, const bool log) {
+	srand(1);
+	unsigned refill_seed = 1;
+	GameControlData control = scenario_control();
+	BaselineWorld world;
+	world.player.x = world.player.prev_x = SCREEN_WIDTH / 2 - PLAYER_WIDTH / 2;
+	world.player.y = world.player.prev_y = SCREEN_HEIGHT - PLAYER_HEIGHT - 100;
+	world.player.type = PLAYER;
+	world.enemy_list = list_init();
+	world.bullet_list = list_init();
+	world.params = scenario_params(scenario);
+	world.control = &control;
+	world.tick = world.last_bullet_spawn_tick = world.last_enemy_spawn_tick = 0;
+	world.log = log;
+
+	std::vector<double> samples;
+	samples.reserve(ticks);
+	const unsigned long long allocations_before = g_allocation_count.load();
+	size_t bullet_count = 0;
+
+	for (int t = 0; t < ticks; ++t) {
+		bullet_count = baseline_count(world.bullet_list);
+		for (; bullet_count < scenario->live_bullets; ++bullet_count) {
+			baseline_append(world.bullet_list, bench_random(&refill_seed) % (SCREEN_WIDTH - BULLET_WIDTH), bench_random(&refill_seed) % SCREEN_HEIGHT, BULLET);
+		}
+
+		const auto begin = std::chrono::steady_clock::now();
+		baseline_step(&world, scripted_input(world.tick));
+		const auto end = std::chrono::steady_clock::now();
+		samples.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+	}
+
+	// 补充子弹时的分配不属于 tick 本身，但 baseline 每颗子弹都要两次 malloc，这里如实计入，与真实游戏中开火的代价一致。
+	BenchResult result;
+	summarize(samples, g_allocation_count.load() - allocations_before, &result);
+	result.final_enemies = baseline_count(world.enemy_list);
+	result.final_bullets = baseline_count(world.bullet_list);
+	result.score = control.score;
+	list_free(world.enemy_list);
+	list_free(world.bullet_list);
+	return result;
+}
+
+static void print_result(const Scenario* scenario, const char* engine, const int ticks, const BenchResult* result, const bool first) {
+	printf("%s\n    {\"scenario\": \"%s\", \"engine\": \"%s\", \"ticks\": %d, \"ns_per_tick\": %.1f, \"allocations_per_tick\": %.3f, "
+		"\"p50_ns\": %.0f, \"p99_ns\": %.0f, \"max_ns\": %.0f, \"final_enemies\": %zu, \"final_bullets\": %zu, \"score\": %d}",
+		first ? "" : ",", scenario->name, engine, ticks, result->ns_per_tick, result->allocations_per_tick,
+		result->p50_ns, result->p99_ns, result->max_ns, result->final_enemies, result->final_bullets, result->score);
+}
+
+int main(int argc, char** argv) {
+	const char* only_scenario = NULL;
+	const char* engine = "both";
+	int ticks_override = 0;
+	int threads = 1;
+	bool log = false;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--scenario") && i + 1 < argc) {
+			only_scenario = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--engine") && i + 1 < argc) {
+			engine = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) {
+			ticks_override = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+			threads = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--log")) {
+			log = true;
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--scenario NAME] [--engine world|baseline|both] [--ticks N] [--threads N] [--log]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (log) {
+#if defined(_WIN32)
+		g_null_sink = fopen("NUL", "w");
+#else
+		g_null_sink = fopen("/dev/null", "w");
+#endif
+		log_start(g_null_sink, LOG_FORMAT_TEXT);
+	}
+
+	jobs_start(threads);
+
+	const bool run_world_engine = strcmp(engine, "baseline") != 0;
+	const bool run_baseline_engine = strcmp(engine, "world") != 0;
+
+	printf("{\n  \"results\": [");
+	bool first = true;
+	for (const Scenario& scenario : g_scenarios) {
+		if (only_scenario && strcmp(only_scenario, scenario.name)) {
+			continue;
+		}
+
+		const int ticks = ticks_override > 0 ? ticks_override : scenario.ticks;
+		if (run_world_engine) {
+			const BenchResult result = run_world(&scenario, ticks);
+			print_result(&scenario, "world", ticks, &result, first);
+			first = false;
+		}
+		if (run_baseline_engine) {
+			const BenchResult result = run_baseline(&scenario, ticks, log);
+			print_result(&scenario, "baseline", ticks, &result, first);
+			first = false;
+		}
+		fflush(stdout);
+	}
+	printf("\n  ]\n}\n");
+
+	jobs_stop();
+
+	if (log) {
+		log_stop();
+		fclose(g_null_sink);
+	}
+
+	return 0;
+}
@@ -0,0 +1,300 @@
+/**
+ * @file collision_test.cpp
+ * @brief SIMD 实现的一致性测试。用随机输入分别比较以下函数的标量、SSE2 与 AVX2 实现，数量包括不是 4 或 8 的倍数的情况：
+ *        collision_batch() 输出的命中位掩码与命中数量，坐标数组故意错开对齐；
+ *        pool_integrate() 移动、删除越界对象并紧凑排列之后池中的全部字段，另外启动任务调度器比较分块并行的结果；
+ *        framebuffer_blend_row_*() 对随机的预乘 alpha 像素混合之后的结果，以标量实现为准，行长度包括奇数。
+ *        任何一项不一致时输出第一个不一致的用例并以非零值退出。
+ *        未开启的指令集对应的实现不参与比较，因此须以 -mavx2 编译才能覆盖全部实现。
+ *
+ *        在 Linux 上编译（于仓库根目录执行）：
+ *            gcc -std=c11 -O2 -mavx2 -c source/collision.c source/rng.c source/pool.c source/arena.c source/object.c source/timer.c \
+ *                source/framebuffer.c
+ *            g++ -std=c++17 -O2 -mavx2 -Isource bench/collision_test.cpp source/jobs.cpp source/log.cpp *.o -o galaxy_collision_test -lpthread
+ *        用法：
+ *            ./galaxy_collision_test [--cases N] [--seed N]
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "collision.h"
+#include "pool.h"
+#include "framebuffer.h"
+#include "jobs.h"
+#include "rng.h"
+
+#define TEST_MAX_COUNT 300 // 一个用例中矩形数量的上限
+#define TEST_MAX_OFFSET 7 // 坐标数组起点最多错开的元素数
+#define TEST_MAX_POOL 600 // 一个用例中池内对象数量的上限
+#define TEST_LARGE_POOL 40000 // 偶尔使用的大池，足以被 pool_integrate() 分成多块并行处理
+#define TEST_THREADS 4 // 任务调度器的线程数
+#define TEST_MAX_ROW 160 // 一个用例中一行像素数量的上限
+
+typedef size_t (*CollisionBatchFunc)(const int x, const int y, const int width, const int height,
+	const int* xs, const int* ys, const size_t count, const int item_width, const int item_height, uint32_t* hit_mask);
+
+/**
+ * @brief 一个待比较的实现。
+ */
+typedef struct CollisionImpl {
+	const char* name;
+	CollisionBatchFunc func;
+} CollisionImpl;
+
+static const CollisionImpl g_collision_impls[] = {
+	{ "scalar", collision_batch_scalar },
+#ifdef COLLISION_HAVE_SSE2
+	{ "sse2", collision_batch_sse2 },
+#endif
+#ifdef COLLISION_HAVE_AVX2
+	{ "avx2", collision_batch_avx2 },
+#endif
+};
+
+/**
+ * @brief 取 [low, high] 内的随机整数。
+ */
+static int test_random(Rng* rng, const int low, const int high) {
+	return low + (int)rng_below(rng, (uint32_t)(high - low + 1));
+}
+
+/**
+ * @brief 比较 collision_batch() 的各个实现。矩形集中在较小的区域内，使命中与未命中都足够多；宽高为 0 的退化情况也会出现。
+ * @return 通过的用例数，等于 cases 时全部通过。
+ */
+static int test_collision_batch(Rng* rng, const int cases) {
+	std::vector<int> xs(TEST_MAX_COUNT + TEST_MAX_OFFSET), ys(TEST_MAX_COUNT + TEST_MAX_OFFSET);
+	std::vector<uint32_t> expected(COLLISION_MASK_WORDS(TEST_MAX_COUNT) + 1), actual(expected.size());
+
+	for (int c = 0; c < cases; ++c) {
+		const size_t count = (size_t)test_random(rng, 0, TEST_MAX_COUNT);
+		const size_t offset = (size_t)test_random(rng, 0, TEST_MAX_OFFSET);
+		const int x = test_random(rng, -100, 300), y = test_random(rng, -100, 300);
+		const int width = test_random(rng, 0, 80), height = test_random(rng, 0, 80);
+		const int item_width = test_random(rng, 0, 80), item_height = test_random(rng, 0, 80);
+		for (size_t i = 0; i < count; ++i) {
+			xs[offset + i] = test_random(rng, -150, 350);
+			ys[offset + i] = test_random(rng, -150, 350);
+		}
+
+		// 逐个矩形直接判断，作为所有实现的参考结果。
+		size_t expected_hits = 0;
+		std::fill(expected.begin(), expected.end(), 0);
+		for (size_t i = 0; i < count; ++i) {
+			const int ix = xs[offset + i], iy = ys[offset + i];
+			if (x < ix + item_width && ix < x + width && y < iy + item_height && iy < y + height) {
+				expected[i / 32] |= 1u << (i % 32);
+				++expected_hits;
+			}
+		}
+
+		for (const CollisionImpl& impl : g_collision_impls) {
+			std::fill(actual.begin(), actual.end(), 0xA5A5A5A5u);
+			const size_t hits = impl.func(x, y, width, height, xs.data() + offset, ys.data() + offset, count, item_width, item_height, actual.data());
+			if (hits != expected_hits || memcmp(actual.data(), expected.data(), sizeof(uint32_t) * COLLISION_MASK_WORDS(count))) {
+				fprintf(stderr, "collision_batch_%s: case %d mismatch (count %zu, offset %zu, rect %d %d %d %d, item %d x %d): %zu hits, expected %zu.\n",
+					impl.name, c, count, offset, x, y, width, height, item_width, item_height, hits, expected_hits);
+				return c;
+			}
+		}
+	}
+	return cases;
+}
+
+typedef size_t (*PoolIntegrateFunc)(ObjectPool* pool, const int min_x, const int min_y, const int max_x, const int max_y);
+
+typedef struct PoolImpl {
+	const char* name;
+	PoolIntegrateFunc func;
+} PoolImpl;
+
+static const PoolImpl g_pool_impls[] = {
+	{ "scalar", pool_integrate_scalar },
+#ifdef COLLISION_HAVE_SSE2
+	{ "sse2", pool_integrate_sse2 },
+#endif
+#ifdef COLLISION_HAVE_AVX2
+	{ "avx2", pool_integrate_avx2 },
+#endif
+	{ "parallel", pool_integrate },
+};
+
+static void pool_copy(ObjectPool* dst, const ObjectPool* src) {
+	memcpy(dst->x, src->x, sizeof(int) * src->count);
+	memcpy(dst->y, src->y, sizeof(int) * src->count);
+	memcpy(dst->vx, src->vx, sizeof(int) * src->count);
+	memcpy(dst->vy, src->vy, sizeof(int) * src->count);
+	memcpy(dst->type, src->type, sizeof(int) * src->count);
+	memcpy(dst->hp, src->hp, sizeof(int) * src->count);
+	dst->count = src->count;
+}
+
+static bool pool_equal(const ObjectPool* a, const ObjectPool* b) {
+	const size_t bytes = sizeof(int) * a->count;
+	return a->count == b->count && !memcmp(a->x, b->x, bytes) && !memcmp(a->y, b->y, bytes) && !memcmp(a->vx, b->vx, bytes) &&
+		!memcmp(a->vy, b->vy, bytes) && !memcmp(a->type, b->type, bytes) && !memcmp(a->hp, b->hp, bytes);
+}
+
+/**
+ * @brief 比较 pool_integrate() 的各个实现。对象分布在边界两侧，速度有正有负，使每趟都有一部分对象被删除。
+ * @return 通过的用例数，等于 cases 时全部通过。
+ */
+static int test_pool_integrate(Rng* rng, const int cases) {
+	ObjectPool input, expected, actual;
+	pool_init(&input, TEST_LARGE_POOL, NULL);
+	pool_init(&expected, TEST_LARGE_POOL, NULL);
+	pool_init(&actual, TEST_LARGE_POOL, NULL);
+
+	int passed = cases;
+	for (int c = 0; c < cases && passed == cases; ++c) {
+		input.count = c % 50 == 0 ? TEST_LARGE_POOL - (size_t)test_random(rng, 0, 7) : (size_t)test_random(rng, 0, TEST_MAX_POOL);
+		const int min_x = test_random(rng, -60, 0), min_y = test_random(rng, -60, 0);
+		const int max_x = test_random(rng, 500, 600), max_y = test_random(rng, 700, 800);
+		for (size_t i = 0; i < input.count; ++i) {
+			input.x[i] = test_random(rng, min_x - 30, max_x + 30);
+			input.y[i] = test_random(rng, min_y - 30, max_y + 30);
+			input.vx[i] = test_random(rng, -20, 20);
+			input.vy[i] = test_random(rng, -20, 20);
+			input.type[i] = test_random(rng, 0, OBJECT_TYPE_COUNT - 1);
+			input.hp[i] = test_random(rng, -5, 5);
+		}
+
+		// 先移动、再按闭区间判断并保持相对顺序，作为所有实现的参考结果。
+		expected.count = 0;
+		for (size_t i = 0; i < input.count; ++i) {
+			const int x = input.x[i] + input.vx[i], y = input.y[i] + input.vy[i];
+			if (x < min_x || x > max_x || y < min_y || y > max_y) {
+				continue;
+			}
+			const size_t k = expected.count++;
+			expected.x[k] = x;
+			expected.y[k] = y;
+			expected.vx[k] = input.vx[i];
+			expected.vy[k] = input.vy[i];
+			expected.type[k] = input.type[i];
+			expected.hp[k] = input.hp[i];
+		}
+
+		for (const PoolImpl& impl : g_pool_impls) {
+			pool_copy(&actual, &input);
+			const size_t erased = impl.func(&actual, min_x, min_y, max_x, max_y);
+			if (erased != input.count - expected.count || !pool_equal(&actual, &expected)) {
+				fprintf(stderr, "pool_integrate_%s: case %d mismatch (count %zu, bounds %d %d %d %d): %zu erased, expected %zu.\n",
+					impl.name, c, input.count, min_x, min_y, max_x, max_y, erased, input.count - expected.count);
+				passed = c;
+				break;
+			}
+		}
+	}
+
+	pool_free(&input);
+	pool_free(&expected);
+	pool_free(&actual);
+	return passed;
+}
+
+typedef void (*BlendRowFunc)(uint32_t* dst, const uint32_t* src, const int count);
+
+typedef struct BlendImpl {
+	const char* name;
+	BlendRowFunc func;
+} BlendImpl;
+
+static const BlendImpl g_blend_impls[] = {
+#ifdef COLLISION_HAVE_SSE2
+	{ "sse2", framebuffer_blend_row_sse2 },
+#endif
+#ifdef COLLISION_HAVE_AVX2
+	{ "avx2", framebuffer_blend_row_avx2 },
+#endif
+};
+
+/**
+ * @brief 随机的预乘 alpha 像素：各颜色通道不超过 alpha。mode 为 0 时全透明，为 1 时全不透明，否则 alpha 任取，
+ *        这样 SIMD 实现整组跳过与整组覆盖的分支也会被覆盖。
+ */
+static uint32_t test_premultiplied(Rng* rng, const int mode) {
+	const uint32_t a = mode == 0 ? 0 : mode == 1 ? 255 : (uint32_t)test_random(rng, 0, 255);
+	uint32_t pixel = a << 24;
+	for (int shift = 0; shift < 24; shift += 8) {
+		pixel |= (uint32_t)test_random(rng, 0, (int)a) << shift;
+	}
+	return pixel;
+}
+
+/**
+ * @brief 比较 framebuffer_blend_row_*() 的 SIMD 实现与标量实现。每行分成若干段，各段内的像素全透明、全不透明或任意。
+ * @return 通过的用例数，等于 cases 时全部通过。
+ */
+static int test_blend_row(Rng* rng, const int cases) {
+	std::vector<uint32_t> src(TEST_MAX_ROW + TEST_MAX_OFFSET), dst(src.size()), expected(src.size()), actual(src.size());
+
+	for (int c = 0; c < cases; ++c) {
+		const int count = test_random(rng, 0, TEST_MAX_ROW);
+		const size_t offset = (size_t)test_random(rng, 0, TEST_MAX_OFFSET);
+		int mode = 2;
+		for (int i = 0; i < count; ++i) {
+			if (rng_below(rng, 8) == 0) {
+				mode = test_random(rng, 0, 2);
+			}
+			src[offset + i] = test_premultiplied(rng, mode);
+			dst[offset + i] = rng_next(rng);
+		}
+
+		expected = dst;
+		framebuffer_blend_row_scalar(expected.data() + offset, src.data() + offset, count);
+
+		for (const BlendImpl& impl : g_blend_impls) {
+			actual = dst;
+			impl.func(actual.data() + offset, src.data() + offset, count);
+			if (actual != expected) {
+				fprintf(stderr, "framebuffer_blend_row_%s: case %d mismatch (count %d, offset %zu).\n", impl.name, c, count, offset);
+				return c;
+			}
+		}
+	}
+	return cases;
+}
+
+int main(int argc, char** argv) {
+	int cases = 2000;
+	uint64_t seed = 1;
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--cases") && i + 1 < argc) {
+			cases = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+			seed = strtoull(argv[++i], NULL, 10);
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--cases N] [--seed N]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	Rng rng;
+	rng_seed(&rng, seed);
+	jobs_start(TEST_THREADS);
+
+	bool ok = true;
+	const int passed = test_collision_batch(&rng, cases);
+	printf("collision_batch: %d / %d cases passed (%zu implementations)\n", passed, cases, sizeof(g_collision_impls) / sizeof(g_collision_impls[0]));
+	ok &= passed == cases;
+
+	const int pool_passed = test_pool_integrate(&rng, cases);
+	printf("pool_integrate: %d / %d cases passed (%zu implementations)\n", pool_passed, cases, sizeof(g_pool_impls) / sizeof(g_pool_impls[0]));
+	ok &= pool_passed == cases;
+
+	const int blend_passed = test_blend_row(&rng, cases);
+	printf("framebuffer_blend_row: %d / %d cases passed (%zu implementations besides scalar)\n", blend_passed, cases, sizeof(g_blend_impls) / sizeof(g_blend_impls[0]));
+	ok &= blend_passed == cases;
+
+	jobs_stop();
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
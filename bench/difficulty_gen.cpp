@@ -0,0 +1,209 @@
+/**
+ * @file difficulty_gen.cpp
+ * @brief 离线的难度表生成工具。解析难度与波次的描述文件（格式见 source/difficulty.cfg），
+ *        生成 source/difficulty_table.h：各难度的参数与所有波次都写成编译期常量，游戏运行时不再解析任何文件。
+ *        描述文件改动后重新运行一次并重新编译即可。难度名称以 \u 转义写出，生成的头文件只含 ASCII，与源文件的编码无关。
+ *
+ *        在 Linux 上编译（于仓库根目录执行）：
+ *            gcc -std=c11 -O2 -c source/difficulty.c source/timer.c
+ *            g++ -std=c++17 -O2 -Isource bench/difficulty_gen.cpp source/log.cpp difficulty.o timer.o -o difficulty_gen -lpthread
+ *        用法：
+ *            ./difficulty_gen source/difficulty.cfg source/difficulty_table.h
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "difficulty.h"
+
+static FILE* open_file(const char* path, const char* mode) {
+#if defined(_MSC_VER)
+	FILE* file = NULL;
+	return fopen_s(&file, path, mode) == 0 ? file : NULL;
+#else
+	return fopen(path, mode);
+#endif
+}
+
+static bool read_file(const char* path, std::string* text) {
+	FILE* file = open_file(path, "rb");
+	if (!file) {
+		return false;
+	}
+	char buffer[4096];
+	size_t read;
+	while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		text->append(buffer, read);
+	}
+	const bool ok = !ferror(file);
+	fclose(file);
+	return ok;
+}
+
+/**
+ * @brief 把 UTF-8 字符串写成只含 ASCII 的宽字符串字面量。
+ * @return 字符串不是合法的 UTF-8 时返回 false。
+ */
+static bool write_wide_literal(FILE* out, const char* utf8) {
+	fputs("L\"", out);
+	const unsigned char* p = (const unsigned char*)utf8;
+	while (*p) {
+		unsigned codepoint;
+		int extra;
+		if (*p < 0x80) {
+			codepoint = *p;
+			extra = 0;
+		}
+		else if ((*p & 0xE0) == 0xC0) {
+			codepoint = *p & 0x1F;
+			extra = 1;
+		}
+		else if ((*p & 0xF0) == 0xE0) {
+			codepoint = *p & 0x0F;
+			extra = 2;
+		}
+		else if ((*p & 0xF8) == 0xF0) {
+			codepoint = *p & 0x07;
+			extra = 3;
+		}
+		else {
+			return false;
+		}
+		++p;
+		for (int i = 0; i < extra; ++i, ++p) {
+			if ((*p & 0xC0) != 0x80) {
+				return false;
+			}
+			codepoint = codepoint << 6 | (*p & 0x3F);
+		}
+
+		if (codepoint >= 0x20 && codepoint < 0x7F && codepoint != '"' && codepoint != '\\') {
+			fputc((int)codepoint, out);
+		}
+		else if (codepoint <= 0xFFFF) {
+			fprintf(out, "\\u%04X", codepoint);
+		}
+		else {
+			fprintf(out, "\\U%08X", codepoint);
+		}
+	}
+	fputc('"', out);
+	return true;
+}
+
+/**
+ * @brief 以能够原样读回的最少小数位数写出一个浮点数。描述文件中的数值不超过 1e6，不需要科学计数法。
+ */
+static void write_double(FILE* out, const double value) {
+	char text[64];
+	for (int decimals = 1; decimals <= 17; ++decimals) {
+		snprintf(text, sizeof(text), "%.*f", decimals, value);
+		if (strtod(text, NULL) == value) {
+			break;
+		}
+	}
+	fputs(text, out);
+}
+
+static void write_ints(FILE* out, const char* name, const int* values, const size_t count) {
+	fprintf(out, "#define DIFFICULTY_TABLE_%s {", name);
+	for (size_t i = 0; i < count; ++i) {
+		fprintf(out, "%s%d", i ? ", " : " ", values[i]);
+	}
+	fprintf(out, " }\n");
+}
+
+static void write_doubles(FILE* out, const char* name, const double* values, const size_t count) {
+	fprintf(out, "#define DIFFICULTY_TABLE_%s {", name);
+	for (size_t i = 0; i < count; ++i) {
+		fputs(i ? ", " : " ", out);
+		write_double(out, values[i]);
+	}
+	fprintf(out, " }\n");
+}
+
+int main(int argc, char** argv) {
+	if (argc != 3) {
+		fprintf(stderr, "usage: difficulty_gen difficulty.cfg difficulty_table.h\n");
+		return EXIT_FAILURE;
+	}
+
+	std::string text;
+	if (!read_file(argv[1], &text)) {
+		fprintf(stderr, "Failed to read %s.\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	static DifficultyConfig config;
+	char error[128];
+	if (!difficulty_parse(&config, text.c_str(), error, sizeof(error))) {
+		fprintf(stderr, "%s: %s\n", argv[1], error);
+		return EXIT_FAILURE;
+	}
+
+	FILE* out = open_file(argv[2], "wb");
+	if (!out) {
+		fprintf(stderr, "Failed to create %s.\n", argv[2]);
+		return EXIT_FAILURE;
+	}
+
+	const size_t count = config.difficulty_count;
+	fprintf(out,
+		"/**\n"
+		" * @file difficulty_table.h\n"
+		" * @brief 各难度的参数表与波次表，由 bench/difficulty_gen.cpp 根据 difficulty.cfg 生成，请勿手动修改。\n"
+		" *        各宏只在 difficulty.c 中用来初始化参数表，DIFFICULTY_COUNT 决定最高分文件中记录的难度数。\n"
+		" */\n"
+		"\n"
+		"#ifndef DIFFICULTY_TABLE_H\n"
+		"#define DIFFICULTY_TABLE_H\n"
+		"\n"
+		"#define DIFFICULTY_COUNT %zu\n"
+		"#define DIFFICULTY_TABLE_NAMES {", count);
+	for (size_t i = 0; i < count; ++i) {
+		fputs(i ? ", " : " ", out);
+		if (!write_wide_literal(out, config.names[i])) {
+			fprintf(stderr, "%s: difficulty name %zu is not valid UTF-8.\n", argv[1], i + 1);
+			fclose(out);
+			return EXIT_FAILURE;
+		}
+	}
+	fprintf(out, " }\n");
+	write_ints(out, "STARTING_HP", config.starting_hp, count);
+	write_ints(out, "DELTA_HP", config.delta_hp, count);
+	write_doubles(out, "MIN_FIRE_GAP", config.min_fire_gap, count);
+	write_doubles(out, "MIN_ENEMY_SPAWN_GAP", config.min_enemy_spawn_gap, count);
+	write_ints(out, "PLAYER_SPEED", config.player_speed, count);
+	write_ints(out, "ENEMY_SPEED", config.enemy_speed, count);
+	write_ints(out, "BULLET_SPEED", config.bullet_speed, count);
+
+	// 波次表：{ 难度, 开始时间, 敌机生成间隔, 每次生成的敌机数, 敌机速度 }
+	fprintf(out, "\n#define DIFFICULTY_TABLE_WAVE_COUNT %zu\n", config.wave_count);
+	if (config.wave_count == 0) {
+		fprintf(out, "#define DIFFICULTY_TABLE_WAVES { { 0 } }\n");
+	}
+	else {
+		fprintf(out, "#define DIFFICULTY_TABLE_WAVES { \\\n");
+		for (size_t i = 0; i < config.wave_count; ++i) {
+			const Wave* wave = &config.waves[i];
+			fprintf(out, "\t{ %d, ", wave->difficulty);
+			write_double(out, wave->at);
+			fputs(", ", out);
+			write_double(out, wave->min_enemy_spawn_gap);
+			fprintf(out, ", %d, %d }%s \\\n", wave->enemies_per_spawn, wave->enemy_speed, i + 1 < config.wave_count ? "," : "");
+		}
+		fprintf(out, "}\n");
+	}
+	fprintf(out, "\n#endif /* DIFFICULTY_TABLE_H */\n");
+
+	if (fclose(out) != 0) {
+		fprintf(stderr, "Failed to write %s.\n", argv[2]);
+		return EXIT_FAILURE;
+	}
+	printf("%s: %zu difficulties, %zu waves.\n", argv[2], count, config.wave_count);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,362 @@
+/**
+ * @file headless.cpp
+ * @brief 无窗口运行完整的游戏流程：模拟线程按固定 tick 推进并发布快照，渲染线程通过 null 或 offscreen 后端绘制，
+ *        结构与窗口程序相同，只是输入来自脚本（经由与窗口程序相同的输入层注入）、没有菜单，一局结束后立即开始下一局。
+ *        结束时以 JSON 格式输出 tick 数、绘制的帧数以及各阶段在最近 256 帧内的耗时统计；offscreen 后端还会在本线程上
+ *        按最终状态重新绘制一帧并输出它的哈希值，与渲染线程的时机无关。没有给出 --atlas 时精灵画成纯色矩形；
+ *        这一帧没有绘制任何精灵时不输出哈希值。--trace 导出 Chrome trace。
+ *        用于在 Linux 构建机上运行与分析整个游戏，而不只是模拟核心。
+ *        输出中的 samples 每秒（WORLD_TICK_RATE 个 tick）记录一次同时存活的对象数与每 tick 的模拟耗时。
+ *        --stress N 以压力测试模式运行（见 world_stress_params()），目标是同时存活 N 个对象；扇形弹幕的子弹数、
+ *        两端的横向速度与每 tick 生成的敌机数可以分别覆盖。配合 --backend null 即为不绘制画面的容量测试。
+ *        --bot 由自动驾驶的玩家（见 bot.h）代替脚本操作；--minutes N 运行 N 分钟后结束，未同时给出 --ticks 时不限 tick 数。
+ *        二者配合 --realtime 即为无人值守的长时间稳定性测试，samples 中的 memory_kb 是进程当时占用的物理内存。
+ *
+ *        在 Linux 上编译（于仓库根目录执行）：
+ *            gcc -std=c11 -O2 -c source/world.c source/arena.c source/difficulty.c source/pool.c source/grid.c source/collision.c source/object.c \
+ *                source/control.c source/timer.c source/rng.c source/atlas.c source/framebuffer.c \
+ *                source/input.c source/bot.c source/render_backend.c source/render_offscreen.c
+ *            g++ -std=c++17 -O2 -Isource bench/headless.cpp source/log.cpp source/jobs.cpp source/profiler.cpp \
+ *                source/snapshot.cpp source/render_thread.cpp *.o -o galaxy_headless -lpthread
+ *        用法：
+ *            ./galaxy_headless [--backend null|offscreen] [--atlas 图集] [--ticks N] [--seed N] [--difficulty D]
+ *                [--threads N] [--realtime] [--trace 文件] [--log]
+ *                [--stress N] [--bullets-per-shot N] [--spread N] [--enemies-per-spawn N] [--bot] [--minutes N]
+ *        默认不限速运行，渲染线程也不限帧率；--realtime 按每秒 WORLD_TICK_RATE 个 tick 运行，与窗口程序相同。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <wchar.h>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+#include "world.h"
+#include "input.h"
+#include "bot.h"
+#include "log.h"
+#include "jobs.h"
+#include "timer.h"
+#include "profiler.h"
+#include "snapshot.h"
+#include "render_backend.h"
+#include "render_thread.h"
+
+#define TICK_SECONDS (1.0 / WORLD_TICK_RATE)
+#define HEADLESS_PATH_SIZE 1024
+
+/**
+ * @brief 每 WORLD_TICK_RATE 个 tick 记录一次的统计。
+ */
+typedef struct HeadlessSample {
+	size_t tick;
+	size_t entities; // 这段时间内同时存活的敌机与子弹数的平均值
+	size_t entities_peak;
+	double step_ms; // 这段时间内每 tick 模拟耗时的平均值
+	double step_ms_max;
+	unsigned long long frames; // 这段时间内绘制的帧数
+	size_t memory_kb; // 进程占用的物理内存，单位：KiB
+} HeadlessSample;
+
+/**
+ * @brief 脚本化的输入：一直开火，左右往返移动，偶尔上下移动。
+ */
+static unsigned scripted_input(const unsigned long long tick) {
+	unsigned input = INPUT_FIRE | ((tick / 45) % 2 ? INPUT_LEFT : INPUT_RIGHT);
+	if (tick % 300 < 30) {
+		input |= (tick / 300) % 2 ? INPUT_DOWN : INPUT_UP;
+	}
+	return input;
+}
+
+/**
+ * @brief 进程当前占用的物理内存，单位：KiB。只在 Linux 上实现，其他平台返回 0。
+ */
+static size_t memory_kb() {
+#if defined(__linux__)
+	FILE* file = fopen("/proc/self/statm", "r");
+	if (!file) {
+		return 0;
+	}
+	unsigned long size = 0, resident = 0;
+	const bool ok = fscanf(file, "%lu %lu", &size, &resident) == 2;
+	fclose(file);
+	return ok ? (size_t)resident * (size_t)sysconf(_SC_PAGESIZE) / 1024 : 0;
+#else
+	return 0;
+#endif
+}
+
+static void print_phases() {
+	printf("\"phases\": {");
+	for (int i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+		const ProfilerStats stats = profiler_stats((ProfilerPhase)i);
+		printf("%s\"%s\": {\"mean\": %.4f, \"p50\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+			i ? ", " : "", profiler_phase_name((ProfilerPhase)i), stats.mean, stats.p50, stats.p99, stats.max);
+	}
+	printf("}");
+}
+
+static void print_samples(const HeadlessSample* samples, const size_t count) {
+	printf("\"samples\": [");
+	for (size_t i = 0; i < count; ++i) {
+		const HeadlessSample* sample = &samples[i];
+		printf("%s{\"tick\": %zu, \"entities\": %zu, \"entities_peak\": %zu, \"step_ms\": %.4f, \"step_ms_max\": %.4f, \"frames\": %llu, "
+			"\"memory_kb\": %zu}",
+			i ? ", " : "", sample->tick, sample->entities, sample->entities_peak, sample->step_ms, sample->step_ms_max, sample->frames,
+			sample->memory_kb);
+	}
+	printf("]");
+}
+
+int main(int argc, char** argv) {
+	const RenderBackend* backend = &render_backend_offscreen;
+	const char* atlas = NULL;
+	const char* trace = NULL;
+	size_t ticks = 60 * WORLD_TICK_RATE;
+	bool ticks_given = false;
+	double minutes = 0;
+	bool bot = false;
+	uint64_t seed = 1;
+	int difficulty = 0;
+	int threads = 1;
+	bool realtime = false;
+	bool log = false;
+	size_t stress = 0;
+	int bullets_per_shot = 0;
+	int spread = -1;
+	int enemies_per_spawn = 0;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--backend") && i + 1 < argc) {
+			++i;
+			backend = !strcmp(argv[i], "null") ? &render_backend_null : !strcmp(argv[i], "offscreen") ? &render_backend_offscreen : NULL;
+			if (!backend) {
+				fprintf(stderr, "Unknown backend: %s\n", argv[i]);
+				return EXIT_FAILURE;
+			}
+		}
+		else if (!strcmp(argv[i], "--atlas") && i + 1 < argc) {
+			atlas = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) {
+			ticks = (size_t)strtoull(argv[++i], NULL, 10);
+			ticks_given = true;
+		}
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+			seed = strtoull(argv[++i], NULL, 10);
+		}
+		else if (!strcmp(argv[i], "--difficulty") && i + 1 < argc) {
+			difficulty = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+			threads = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--trace") && i + 1 < argc) {
+			trace = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--stress") && i + 1 < argc) {
+			stress = (size_t)strtoull(argv[++i], NULL, 10);
+		}
+		else if (!strcmp(argv[i], "--bullets-per-shot") && i + 1 < argc) {
+			bullets_per_shot = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--spread") && i + 1 < argc) {
+			spread = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--enemies-per-spawn") && i + 1 < argc) {
+			enemies_per_spawn = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--minutes") && i + 1 < argc) {
+			minutes = atof(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--bot")) {
+			bot = true;
+		}
+		else if (!strcmp(argv[i], "--realtime")) {
+			realtime = true;
+		}
+		else if (!strcmp(argv[i], "--log")) {
+			log = true;
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--backend null|offscreen] [--atlas FILE] [--ticks N] [--seed N] [--difficulty D] "
+				"[--threads N] [--realtime] [--trace FILE] [--log] [--stress N] [--bullets-per-shot N] [--spread N] "
+				"[--enemies-per-spawn N] [--bot] [--minutes N]\n", argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (minutes > 0 && !ticks_given) {
+		ticks = SIZE_MAX;
+	}
+	if (difficulty < 0 || difficulty >= DIFFICULTY_COUNT) {
+		fprintf(stderr, "Invalid difficulty %d.\n", difficulty);
+		return EXIT_FAILURE;
+	}
+
+	WorldParams params = stress ? world_stress_params(stress) : world_default_params(difficulty);
+	if (bullets_per_shot > 0) {
+		params.bullets_per_shot = bullets_per_shot;
+	}
+	if (spread >= 0) {
+		params.bullet_spread = spread;
+	}
+	if (enemies_per_spawn > 0) {
+		params.enemies_per_spawn = enemies_per_spawn;
+	}
+
+	if (log) {
+		log_start(stderr, LOG_FORMAT_TEXT);
+	}
+	jobs_start(threads);
+
+	backend->open(SCREEN_WIDTH, SCREEN_HEIGHT, L"galaxy");
+	if (atlas) {
+		wchar_t path[HEADLESS_PATH_SIZE];
+		if (mbstowcs(path, atlas, HEADLESS_PATH_SIZE) >= HEADLESS_PATH_SIZE || !backend->load_textures(path)) {
+			fprintf(stderr, "Failed to load atlas %s.\n", atlas);
+			return EXIT_FAILURE;
+		}
+	}
+
+	profiler_set_overlay(true);
+	if (trace) {
+		profiler_trace_start(trace);
+	}
+
+	GameControlData control = { MENU, 0, 0, true };
+	GameWorld world;
+	InputQueue input;
+	input_init(&input);
+	size_t sessions = 1;
+	world_init_with_params(&world, &control, difficulty, &params, seed);
+	game_control_start(&control, starting_hp[difficulty]);
+
+	HeadlessSample* samples = NULL;
+	size_t sample_count = 0, sample_capacity = 0;
+	int best_score = 0;
+	size_t window_ticks = 0, window_entities = 0, window_peak = 0, entities_peak = 0;
+	double window_seconds = 0, window_max = 0;
+	unsigned long long window_frames = 0;
+
+	snapshot_init(params.capacity);
+	snapshot_publish(&world);
+	render_thread_start(backend, TICK_SECONDS, !realtime);
+	render_thread_resume();
+
+	const double begin = timer_now();
+	size_t t = 0;
+	for (; t < ticks; ++t) {
+		if (minutes > 0 && timer_now() - begin >= minutes * 60) {
+			break;
+		}
+
+		PROFILE_BEGIN(PROFILE_FRAME);
+		if (control.state != PLAYING) {
+			best_score = control.score > best_score ? control.score : best_score;
+			world_restart(&world, difficulty, &params, seed + sessions++);
+			game_control_start(&control, starting_hp[difficulty]);
+			input_reset(&input);
+		}
+
+		input_inject(&input, bot ? bot_input(&world) : scripted_input(world.tick));
+		const double step_begin = timer_now();
+		world_step(&world, input_held(input_tick(&input)));
+		snapshot_publish(&world);
+		const double step_seconds = timer_now() - step_begin;
+
+		const size_t entities = world_object_count(&world);
+		window_entities += entities;
+		window_peak = entities > window_peak ? entities : window_peak;
+		window_seconds += step_seconds;
+		window_max = step_seconds > window_max ? step_seconds : window_max;
+		if (++window_ticks == WORLD_TICK_RATE || t + 1 == ticks) {
+			const unsigned long long frames = render_thread_frame_count();
+			if (sample_count == sample_capacity) {
+				sample_capacity = sample_capacity ? sample_capacity * 2 : 64;
+				HeadlessSample* grown = (HeadlessSample*)realloc(samples, sample_capacity * sizeof(HeadlessSample));
+				if (!grown) {
+					fprintf(stderr, "malloc() failed.\n");
+					exit(EXIT_FAILURE);
+				}
+				samples = grown;
+			}
+			samples[sample_count++] = HeadlessSample{
+				t + 1,
+				window_entities / window_ticks,
+				window_peak,
+				window_seconds * 1000 / window_ticks,
+				window_max * 1000,
+				frames - window_frames,
+				memory_kb()
+			};
+			entities_peak = window_peak > entities_peak ? window_peak : entities_peak;
+			window_frames = frames;
+			window_ticks = window_entities = window_peak = 0;
+			window_seconds = window_max = 0;
+		}
+
+		if (realtime) {
+			PROFILE_BEGIN(PROFILE_SLEEP);
+			timer_sleep(begin + (t + 1) * TICK_SECONDS - timer_now());
+			PROFILE_END(PROFILE_SLEEP);
+		}
+		PROFILE_END(PROFILE_FRAME);
+		profiler_frame_end();
+	}
+	const double seconds = timer_now() - begin;
+	ticks = t;
+	best_score = control.score > best_score ? control.score : best_score;
+
+	render_thread_stop();
+	const unsigned long long frames = render_thread_frame_count();
+
+	printf("{\"backend\": \"%s\", \"ticks\": %zu, \"sessions\": %zu, \"frames\": %llu, \"seconds\": %.6f, \"ticks_per_second\": %.0f, "
+		"\"frames_per_second\": %.0f, \"score\": %d, \"best_score\": %d, \"hash\": \"%016" PRIx64 "\", \"entities_peak\": %zu",
+		backend->name, ticks, sessions, frames, seconds, seconds > 0 ? ticks / seconds : 0.0,
+		seconds > 0 ? frames / seconds : 0.0, control.score, best_score, world_hash(&world), entities_peak);
+
+	// 最后一帧在本线程上按最终状态重新绘制，哈希值只取决于模拟结果与图集（或者代替图集的纯色矩形）。
+	if (backend == &render_backend_offscreen) {
+		const GameplayVisualState state{
+			SCREEN_WIDTH,
+			SCREEN_HEIGHT,
+			control.score,
+			L"",
+			(const Object*)world.player,
+			world.pools,
+			difficulty,
+			control.hp,
+			starting_hp[difficulty],
+			1.0
+		};
+		render_gameplay(backend, &state);
+		if (render_offscreen_sprite_count() > 0) {
+			printf(", \"frame_hash\": \"%016" PRIx64 "\"", framebuffer_hash(render_offscreen_frame()));
+		}
+	}
+	printf(", ");
+	print_phases();
+	printf(", ");
+	print_samples(samples, sample_count);
+	printf("}\n");
+	free(samples);
+
+	if (trace && !profiler_trace_stop()) {
+		fprintf(stderr, "Failed to write trace %s.\n", trace);
+	}
+
+	backend->close();
+	snapshot_free();
+	world_free(&world);
+	jobs_stop();
+	if (log) {
+		log_stop();
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,302 @@
+/**
+ * @file replay_play.cpp
+ * @brief 无窗口的录像回放工具。读取录像后以最快速度逐 tick 重放输入，以 JSON 格式输出 tick 数、最终得分、生命值、
+ *        模拟状态的哈希值与回放耗时。给出 --expect 时比较哈希值，不一致则以非零值退出，可用作逐位一致的回归测试。
+ *        --record 用脚本化的输入生成一段录像，便于在没有窗口的环境中制作回归用例。
+ *        给出多段录像时由任务调度器分发到所有 CPU 核心上并行回放（--threads 指定线程数），逐段输出结果后再输出一行汇总，
+ *        任何一段回放失败都以非零值退出，可用于在服务器上批量校验玩家上传的录像。
+ *        给出 --atlas 时还会用 offscreen 渲染后端与 render_gameplay() 把最后一帧合成到内存中的帧缓冲区，输出它的哈希值，
+ *        用于在没有窗口的环境中检查渲染结果。绘制流程与 bench/headless.cpp 相同，两者的 frame_hash 可以互相比较。
+ *
+ *        在 Linux 上编译（于仓库根目录执行）：
+ *            gcc -std=c11 -O2 -c source/world.c source/arena.c source/difficulty.c source/pool.c source/grid.c source/collision.c source/object.c \
+ *                source/control.c source/timer.c source/rng.c source/replay.c source/atlas.c source/framebuffer.c source/render_backend.c \
+ *                source/render_offscreen.c
+ *            g++ -std=c++17 -O2 -Isource bench/replay_play.cpp source/log.cpp source/jobs.cpp source/profiler.cpp *.o -o galaxy_replay -lpthread
+ *        用法：
+ *            ./galaxy_replay 录像文件... [--expect 哈希值] [--threads N] [--atlas source/image/galaxy.atlas]
+ *            ./galaxy_replay 录像文件 --record [--seed N] [--difficulty D] [--ticks N]
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include "world.h"
+#include "replay.h"
+#include "log.h"
+#include "jobs.h"
+#include "render_backend.h"
+
+#define REPLAY_PATH_SIZE 1024
+
+/**
+ * @brief 生成录像时使用的脚本化输入：一直开火，左右往返移动，偶尔上下移动。
+ */
+static unsigned scripted_input(const unsigned long long tick) {
+	unsigned input = INPUT_FIRE | ((tick / 45) % 2 ? INPUT_LEFT : INPUT_RIGHT);
+	if (tick % 300 < 30) {
+		input |= (tick / 300) % 2 ? INPUT_DOWN : INPUT_UP;
+	}
+	return input;
+}
+
+static int record(const char* path, const uint64_t seed, const int difficulty, const size_t ticks) {
+	GameControlData control = { MENU, 0, 0, true };
+	GameWorld world;
+	Replay replay;
+	world_init(&world, &control, difficulty, seed);
+	replay_init(&replay, seed, difficulty);
+	game_control_start(&control, starting_hp[difficulty]);
+
+	for (size_t t = 0; t < ticks && control.state == PLAYING; ++t) {
+		const unsigned input = scripted_input(world.tick);
+		replay_record(&replay, input);
+		world_step(&world, input);
+	}
+
+	const bool ok = replay_save(&replay, path);
+	printf("{\"recorded\": \"%s\", \"ticks\": %zu, \"score\": %d, \"hp\": %d, \"hash\": \"%016" PRIx64 "\"}\n",
+		path, replay.tick_count, control.score, control.hp, world_hash(&world));
+
+	replay_free(&replay);
+	world_free(&world);
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief 回放一段录像的结果。
+ */
+struct PlayResult {
+	bool loaded;
+	uint64_t seed;
+	int difficulty;
+	size_t ticks, recorded_ticks;
+	int score, hp;
+	char hash[17];
+	char frame_hash[17]; // 最后一帧画面的哈希值，未给出图集时为空
+	double seconds;
+};
+
+/**
+ * @brief offscreen 后端只有一块帧缓冲区，并行回放的各段录像依次绘制最后一帧。
+ */
+static std::mutex g_frame_mutex;
+
+/**
+ * @brief 用 offscreen 后端绘制模拟状态的当前帧（插值系数为 1），返回画面的哈希值。
+ */
+static uint64_t draw_frame(const GameWorld* world, const GameControlData* control) {
+	std::lock_guard<std::mutex> lock(g_frame_mutex);
+	const GameplayVisualState state{
+		SCREEN_WIDTH,
+		SCREEN_HEIGHT,
+		control->score,
+		L"",
+		world->player,
+		world->pools,
+		world->difficulty,
+		control->hp,
+		starting_hp[world->difficulty],
+		1.0
+	};
+	render_gameplay(&render_backend_offscreen, &state);
+	return framebuffer_hash(render_offscreen_frame());
+}
+
+static bool play(const char* path, const bool render, PlayResult* result) {
+	memset(result, 0, sizeof(*result));
+
+	Replay replay;
+	if (!replay_load(&replay, path)) {
+		fprintf(stderr, "Failed to load replay %s.\n", path);
+		return false;
+	}
+	if (replay.difficulty < 0 || replay.difficulty >= DIFFICULTY_COUNT) {
+		fprintf(stderr, "Invalid difficulty %d in replay %s.\n", replay.difficulty, path);
+		replay_free(&replay);
+		return false;
+	}
+
+	GameControlData control = { MENU, 0, 0, true };
+	GameWorld world;
+	world_init(&world, &control, replay.difficulty, replay.seed);
+	game_control_start(&control, starting_hp[replay.difficulty]);
+
+	const auto begin = std::chrono::steady_clock::now();
+	size_t played = 0;
+	while (played < replay.tick_count && control.state == PLAYING) {
+		world_step(&world, replay.inputs[played++]);
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	result->loaded = true;
+	result->seed = replay.seed;
+	result->difficulty = replay.difficulty;
+	result->ticks = played;
+	result->recorded_ticks = replay.tick_count;
+	result->score = control.score;
+	result->hp = control.hp;
+	snprintf(result->hash, sizeof(result->hash), "%016" PRIx64, world_hash(&world));
+	result->seconds = std::chrono::duration<double>(end - begin).count();
+
+	if (render) {
+		snprintf(result->frame_hash, sizeof(result->frame_hash), "%016" PRIx64, draw_frame(&world, &control));
+	}
+
+	world_free(&world);
+	replay_free(&replay);
+	return result->ticks == result->recorded_ticks;
+}
+
+/**
+ * @brief 批量校验多段录像：每段录像是一个任务，由任务调度器分发到所有线程上。
+ */
+struct Batch {
+	char** paths;
+	bool render;
+	std::vector<PlayResult> results;
+	std::vector<char> ok;
+};
+
+static void play_chunk(void* context, const size_t begin, const size_t end, const size_t chunk) {
+	Batch* batch = (Batch*)context;
+	(void)chunk;
+	for (size_t i = begin; i < end; ++i) {
+		batch->ok[i] = play(batch->paths[i], batch->render, &batch->results[i]);
+	}
+}
+
+static int play_all(char** paths, const size_t count, const char* expect, const bool render) {
+	Batch batch;
+	batch.paths = paths;
+	batch.render = render;
+	batch.results.resize(count);
+	batch.ok.resize(count);
+
+	const auto begin = std::chrono::steady_clock::now();
+	jobs_parallel_for(count, 1, play_chunk, &batch);
+	const auto end = std::chrono::steady_clock::now();
+
+	// 结果按命令行中的顺序输出，与各段录像实际完成的先后无关。
+	size_t passed = 0, total_ticks = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const PlayResult* result = &batch.results[i];
+		if (!result->loaded) {
+			continue;
+		}
+
+		printf("{\"replay\": \"%s\", \"seed\": %" PRIu64 ", \"difficulty\": %d, \"ticks\": %zu, \"recorded_ticks\": %zu, "
+			"\"score\": %d, \"hp\": %d, \"hash\": \"%s\", \"seconds\": %.6f, \"speedup\": %.1f",
+			paths[i], result->seed, result->difficulty, result->ticks, result->recorded_ticks,
+			result->score, result->hp, result->hash, result->seconds,
+			result->seconds > 0 ? result->ticks / (double)WORLD_TICK_RATE / result->seconds : 0.0);
+		if (render) {
+			printf(", \"frame_hash\": \"%s\"", result->frame_hash);
+		}
+		printf("}\n");
+
+		const bool ok = batch.ok[i] && (!expect || !strcmp(expect, result->hash));
+		if (!ok) {
+			fprintf(stderr, "Replay %s diverged: played %zu of %zu ticks, hash %s, expected %s.\n",
+				paths[i], result->ticks, result->recorded_ticks, result->hash, expect ? expect : "-");
+		}
+		passed += ok;
+		total_ticks += result->ticks;
+	}
+
+	if (count > 1) {
+		const double seconds = std::chrono::duration<double>(end - begin).count();
+		printf("{\"replays\": %zu, \"passed\": %zu, \"threads\": %d, \"ticks\": %zu, \"seconds\": %.6f, \"ticks_per_second\": %.0f}\n",
+			count, passed, jobs_thread_count(), total_ticks, seconds, seconds > 0 ? total_ticks / seconds : 0.0);
+	}
+
+	return passed == count ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char** argv) {
+	const char* usage = "Usage: %s replay... [--expect hash] [--threads N] [--atlas file] | replay --record [--seed N] [--difficulty D] [--ticks N]\n";
+	if (argc < 2) {
+		fprintf(stderr, usage, argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::vector<char*> paths;
+	const char* expect = NULL;
+	const char* atlas = NULL;
+	bool recording = false;
+	uint64_t seed = 1;
+	int difficulty = 0;
+	int threads = 0;
+	size_t ticks = 60 * WORLD_TICK_RATE;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--record")) {
+			recording = true;
+		}
+		else if (!strcmp(argv[i], "--expect") && i + 1 < argc) {
+			expect = argv[++i];
+		}
+		else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+			seed = strtoull(argv[++i], NULL, 10);
+		}
+		else if (!strcmp(argv[i], "--difficulty") && i + 1 < argc) {
+			difficulty = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) {
+			ticks = (size_t)strtoull(argv[++i], NULL, 10);
+		}
+		else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+			threads = atoi(argv[++i]);
+		}
+		else if (!strcmp(argv[i], "--atlas") && i + 1 < argc) {
+			atlas = argv[++i];
+		}
+		else if (argv[i][0] != '-') {
+			paths.push_back(argv[i]);
+		}
+		else {
+			fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (paths.empty() || (recording && paths.size() > 1)) {
+		fprintf(stderr, usage, argv[0]);
+		return EXIT_FAILURE;
+	}
+	if (recording && (difficulty < 0 || difficulty >= DIFFICULTY_COUNT)) {
+		fprintf(stderr, "Invalid difficulty %d.\n", difficulty);
+		return EXIT_FAILURE;
+	}
+
+	if (recording) {
+		return record(paths[0], seed, difficulty, ticks);
+	}
+
+	// 给出图集时必须加载成功，不退回 offscreen 后端的纯色矩形，以免画面的哈希值悄悄变成另一种含义。
+	if (atlas) {
+		wchar_t atlas_path[REPLAY_PATH_SIZE];
+		render_backend_offscreen.open(SCREEN_WIDTH, SCREEN_HEIGHT, L"galaxy");
+		if (mbstowcs(atlas_path, atlas, REPLAY_PATH_SIZE) >= REPLAY_PATH_SIZE || !render_backend_offscreen.load_textures(atlas_path)) {
+			fprintf(stderr, "Failed to load atlas %s.\n", atlas);
+			render_backend_offscreen.close();
+			return EXIT_FAILURE;
+		}
+	}
+
+	jobs_start(threads);
+	const int status = play_all(paths.data(), paths.size(), expect, atlas != NULL);
+	jobs_stop();
+
+	if (atlas) {
+		render_backend_offscreen.close();
+	}
+	return status;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file arena.c
+ * @brief 这份源文件实现了一局游戏专用的内存区域。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "arena.h"
+
+struct ArenaBlock {
+	ArenaBlock* next;
+	size_t size; // data 的字节数
+	unsigned char* data; // 紧跟在块头之后
+};
+
+static void* arena_malloc(const size_t bytes) {
+	void* memory = malloc(bytes ? bytes : 1);
+	if (!memory) {
+		fprintf(stderr, "malloc() failed.\n");
+		exit(EXIT_FAILURE);
+	}
+	return memory;
+}
+
+/**
+ * @brief 在块中从 used 开始划分 bytes 字节。
+ * @return 块中剩余空间不够时返回 NULL。
+ */
+static void* arena_block_alloc(const ArenaBlock* block, size_t* used, const size_t bytes) {
+	const uintptr_t begin = (uintptr_t)block->data;
+	const uintptr_t aligned = (begin + *used + ARENA_ALIGNMENT - 1) & ~(uintptr_t)(ARENA_ALIGNMENT - 1);
+	if (aligned - begin > block->size || bytes > block->size - (aligned - begin)) {
+		return NULL;
+	}
+	*used = aligned - begin + bytes;
+	return (void*)aligned;
+}
+
+void arena_init(Arena* arena, const size_t block_size) {
+	arena->head = arena->current = NULL;
+	arena->used = 0;
+	arena->block_size = block_size;
+	arena->reserved = 0;
+}
+
+void* arena_alloc(Arena* arena, const size_t bytes) {
+	if (!arena) {
+		return arena_malloc(bytes);
+	}
+
+	if (arena->current) {
+		void* memory = arena_block_alloc(arena->current, &arena->used, bytes);
+		if (memory) {
+			return memory;
+		}
+	}
+
+	// 重置之后沿用原来的块，只有放不下时才申请新块，并插在当前块之后。
+	ArenaBlock* next = arena->current ? arena->current->next : arena->head;
+	if (!next || next->size < bytes + ARENA_ALIGNMENT) {
+		const size_t size = bytes + ARENA_ALIGNMENT > arena->block_size ? bytes + ARENA_ALIGNMENT : arena->block_size;
+		ArenaBlock* block = (ArenaBlock*)arena_malloc(sizeof(ArenaBlock) + size);
+		block->size = size;
+		block->data = (unsigned char*)(block + 1);
+		block->next = next;
+		if (arena->current) {
+			arena->current->next = block;
+		}
+		else {
+			arena->head = block;
+		}
+		arena->reserved += size;
+		next = block;
+	}
+
+	arena->current = next;
+	arena->used = 0;
+	return arena_block_alloc(next, &arena->used, bytes);
+}
+
+void arena_reset(Arena* arena) {
+	arena->current = NULL;
+	arena->used = 0;
+}
+
+void arena_free(Arena* arena) {
+	ArenaBlock* block = arena->head;
+	while (block) {
+		ArenaBlock* next = block->next;
+		free(block);
+		block = next;
+	}
+	arena_init(arena, arena->block_size);
+}
@@ -0,0 +1,59 @@
+/**
+ * @file arena.h
+ * @brief 这份头文件声明了一局游戏专用的内存区域（arena）。一局游戏的模拟状态全部从中顺序划分，
+ *        重新开始时 O(1) 地整体重置、原样复用已申请的内存块，不再逐个释放，也不会随运行时间增加堆碎片。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#define ARENA_ALIGNMENT 64 // 每次划分的起始地址按缓存行对齐，也满足 SIMD 的对齐要求
+
+	typedef struct ArenaBlock ArenaBlock;
+
+	/**
+	 * @brief 由若干内存块串成的内存区域。块只在 arena_free() 时释放，重置后按原来的顺序复用。
+	 */
+	typedef struct Arena {
+		ArenaBlock* head;
+		ArenaBlock* current; // 正在划分的块
+		size_t used; // current 中已划分的字节数
+		size_t block_size; // 新块的最小大小，单位：字节
+		size_t reserved; // 统计：已申请的总字节数
+	} Arena;
+
+	/**
+	 * @brief 初始化内存区域。此时不申请内存，第一次划分时才申请第一个块。
+	 */
+	void arena_init(Arena* arena, const size_t block_size);
+
+	/**
+	 * @brief 划分 bytes 字节，起始地址按 ARENA_ALIGNMENT 对齐，内容未初始化。当前块不够时换用下一个块或申请新块。
+	 *        arena 为 NULL 时退回 malloc()，由调用者自行 free()。
+	 */
+	void* arena_alloc(Arena* arena, const size_t bytes);
+
+	/**
+	 * @brief O(1) 作废之前划分的所有内存，与划分了多少无关。内存块保留，供之后的划分复用。
+	 */
+	void arena_reset(Arena* arena);
+
+	/**
+	 * @brief 释放所有内存块。
+	 */
+	void arena_free(Arena* arena);
+
+#endif /* ARENA_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,111 @@
+/**
+ * @file atlas.c
+ * @brief 这份源文件实现了精灵图集的解析与索引生成。文件的映射与像素的上传由渲染器负责，这里不涉及任何平台相关的代码。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <string.h>
+#include "atlas.h"
+
+static const unsigned char atlas_magic[4] = { 'G', 'A', 'T', 'L' };
+
+static void put_uint32(unsigned char* data, const uint32_t value) {
+	data[0] = (unsigned char)(value & 0xFF);
+	data[1] = (unsigned char)(value >> 8 & 0xFF);
+	data[2] = (unsigned char)(value >> 16 & 0xFF);
+	data[3] = (unsigned char)(value >> 24 & 0xFF);
+}
+
+static uint32_t get_uint32(const unsigned char* data) {
+	return (uint32_t)data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24;
+}
+
+size_t atlas_file_size(const int width, const int height, const size_t sprite_count, size_t* pixel_offset) {
+	const size_t index_end = ATLAS_HEADER_SIZE + ATLAS_ENTRY_SIZE * sprite_count;
+	const size_t offset = (index_end + ATLAS_ALIGNMENT - 1) / ATLAS_ALIGNMENT * ATLAS_ALIGNMENT;
+	if (pixel_offset) {
+		*pixel_offset = offset;
+	}
+	return offset + sizeof(uint32_t) * (size_t)width * (size_t)height;
+}
+
+void atlas_write_index(void* data, const int width, const int height, const AtlasSprite* sprites, const size_t sprite_count) {
+	unsigned char* p = (unsigned char*)data;
+	size_t pixel_offset;
+	atlas_file_size(width, height, sprite_count, &pixel_offset);
+
+	memset(p, 0, pixel_offset);
+	memcpy(p, atlas_magic, sizeof(atlas_magic));
+	put_uint32(p + 4, ATLAS_VERSION);
+	put_uint32(p + 8, (uint32_t)width);
+	put_uint32(p + 12, (uint32_t)height);
+	put_uint32(p + 16, (uint32_t)sprite_count);
+	put_uint32(p + 20, (uint32_t)pixel_offset);
+
+	for (size_t i = 0; i < sprite_count; ++i) {
+		unsigned char* entry = p + ATLAS_HEADER_SIZE + ATLAS_ENTRY_SIZE * i;
+		for (size_t k = 0; k < ATLAS_NAME_SIZE - 1 && sprites[i].name[k]; ++k) {
+			entry[k] = (unsigned char)sprites[i].name[k];
+		}
+		put_uint32(entry + ATLAS_NAME_SIZE, (uint32_t)sprites[i].x);
+		put_uint32(entry + ATLAS_NAME_SIZE + 4, (uint32_t)sprites[i].y);
+		put_uint32(entry + ATLAS_NAME_SIZE + 8, (uint32_t)sprites[i].width);
+		put_uint32(entry + ATLAS_NAME_SIZE + 12, (uint32_t)sprites[i].height);
+	}
+}
+
+bool atlas_parse(Atlas* atlas, const void* data, const size_t size) {
+	const unsigned char* p = (const unsigned char*)data;
+	if (size < ATLAS_HEADER_SIZE || memcmp(p, atlas_magic, sizeof(atlas_magic)) || get_uint32(p + 4) != ATLAS_VERSION) {
+		return false;
+	}
+
+	const uint32_t width = get_uint32(p + 8), height = get_uint32(p + 12);
+	const uint32_t sprite_count = get_uint32(p + 16), pixel_offset = get_uint32(p + 20);
+	if (width == 0 || height == 0 || width > ATLAS_MAX_SIZE || height > ATLAS_MAX_SIZE || sprite_count > ATLAS_MAX_SPRITES) {
+		return false;
+	}
+
+	size_t expected_offset;
+	const size_t expected_size = atlas_file_size((int)width, (int)height, sprite_count, &expected_offset);
+	if (pixel_offset != expected_offset || size < expected_size) {
+		return false;
+	}
+
+	atlas->width = (int)width;
+	atlas->height = (int)height;
+	atlas->sprite_count = sprite_count;
+	for (size_t i = 0; i < sprite_count; ++i) {
+		const unsigned char* entry = p + ATLAS_HEADER_SIZE + ATLAS_ENTRY_SIZE * i;
+		AtlasSprite* sprite = &atlas->sprites[i];
+
+		if (memchr(entry, 0, ATLAS_NAME_SIZE) == NULL) {
+			return false;
+		}
+		memcpy(sprite->name, entry, ATLAS_NAME_SIZE);
+
+		const uint32_t x = get_uint32(entry + ATLAS_NAME_SIZE), y = get_uint32(entry + ATLAS_NAME_SIZE + 4);
+		const uint32_t w = get_uint32(entry + ATLAS_NAME_SIZE + 8), h = get_uint32(entry + ATLAS_NAME_SIZE + 12);
+		if (x > width || y > height || w > width - x || h > height - y) {
+			return false;
+		}
+		sprite->x = (int)x;
+		sprite->y = (int)y;
+		sprite->width = (int)w;
+		sprite->height = (int)h;
+	}
+
+	atlas->pixels = (const uint32_t*)(p + pixel_offset);
+	return true;
+}
+
+const AtlasSprite* atlas_find(const Atlas* atlas, const char* name) {
+	for (size_t i = 0; i < atlas->sprite_count; ++i) {
+		if (!strcmp(atlas->sprites[i].name, name)) {
+			return &atlas->sprites[i];
+		}
+	}
+	return NULL;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file atlas.h
+ * @brief 这份头文件声明了精灵图集的文件格式与解析函数。图集由离线工具 bench/atlas_pack.cpp 生成，
+ *        把所有精灵预先解码、拼入同一张图像，运行时只需映射文件并校验索引，不再逐个解码 PNG。
+ *
+ *        文件格式（整数均为小端序）：
+ *            "GATL"、版本号、图像宽、图像高、精灵数、像素数据的偏移（各 4 字节），
+ *            精灵数个索引项：名称（ATLAS_NAME_SIZE 字节，以 0 结尾）、x、y、宽、高（各 4 字节），
+ *            自偏移处开始，宽 × 高个像素，每个像素是 EasyX 图像缓冲区中的一个 DWORD，原样保存。
+ *        像素数据的偏移按 ATLAS_ALIGNMENT 字节对齐，映射后可以直接整块复制。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#define ATLAS_VERSION 1
+#define ATLAS_NAME_SIZE 24 // 精灵名称的最大长度，含结尾的 0
+#define ATLAS_HEADER_SIZE 24
+#define ATLAS_ENTRY_SIZE (ATLAS_NAME_SIZE + 16)
+#define ATLAS_ALIGNMENT 16
+#define ATLAS_MAX_SPRITES 64
+#define ATLAS_MAX_SIZE 8192 // 图像宽高的上限，单位：像素
+
+	/**
+	 * @brief 图集中的一个精灵：名称与它在图集图像中占据的矩形。
+	 */
+	typedef struct AtlasSprite {
+		char name[ATLAS_NAME_SIZE];
+		int x, y;
+		int width, height;
+	} AtlasSprite;
+
+	/**
+	 * @brief 解析后的图集。pixels 指向调用者提供的文件数据内部，不复制像素。
+	 */
+	typedef struct Atlas {
+		int width, height;
+		size_t sprite_count;
+		AtlasSprite sprites[ATLAS_MAX_SPRITES];
+		const uint32_t* pixels; // width * height 个像素，逐行存放
+	} Atlas;
+
+	/**
+	 * @brief 解析并校验内存中（通常是映射到内存的文件）的图集。data 须按 4 字节对齐，且在使用 atlas 期间保持有效。
+	 * @return 格式错误、版本不符或任何精灵越出图像时返回 false。
+	 */
+	bool atlas_parse(Atlas* atlas, const void* data, const size_t size);
+
+	/**
+	 * @brief 按名称查找精灵。
+	 * @return 找不到时返回 NULL。
+	 */
+	const AtlasSprite* atlas_find(const Atlas* atlas, const char* name);
+
+	/**
+	 * @brief 计算图集文件的总字节数与像素数据的偏移，生成图集时使用。
+	 */
+	size_t atlas_file_size(const int width, const int height, const size_t sprite_count, size_t* pixel_offset);
+
+	/**
+	 * @brief 把文件头与索引写入 data 的开头，生成图集时使用。像素数据由调用者写入偏移处。
+	 */
+	void atlas_write_index(void* data, const int width, const int height, const AtlasSprite* sprites, const size_t sprite_count);
+
+#endif /* ATLAS_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,141 @@
+/**
+ * @file bot.c
+ * @brief 这份源文件实现了自动驾驶的玩家。每个 tick 依次评估九个移动方向（含不动）：
+ *        假设玩家沿这个方向移动后停住，敌机保持当前速度，计算在 BOT_HORIZON 个 tick 内会撞上哪些敌机、最早在第几个 tick，
+ *        越早撞上代价越高；没有危险的方向中，选离目标（最近的一架可以击中的敌机下方）最近的一个。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <limits.h>
+#include "bot.h"
+
+/**
+ * @brief 向下取整的整数除法，除数为正。
+ */
+static inline int floor_div(const int a, const int b) {
+	return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/**
+ * @brief 求满足 low < p + v * t < high 的整数 t 在 [1, BOT_HORIZON] 内的范围。
+ * @return 范围为空时返回 false。
+ */
+static bool bot_axis(const int p, const int v, const int low, const int high, int* first, int* last) {
+	if (v == 0) {
+		*first = 1;
+		*last = BOT_HORIZON;
+		return low < p && p < high;
+	}
+	if (v < 0) {
+		return bot_axis(-p, -v, -high, -low, first, last);
+	}
+
+	*first = floor_div(low - p, v) + 1;
+	*last = -floor_div(p - high, v) - 1; // ceil((high - p) / v) - 1
+	if (*first < 1) {
+		*first = 1;
+	}
+	if (*last > BOT_HORIZON) {
+		*last = BOT_HORIZON;
+	}
+	return *first <= *last;
+}
+
+/**
+ * @brief 玩家停在 (x, y) 时与敌机相撞的代价：每架会撞上的敌机按撞上的时刻计分，越早越高。
+ */
+static long long bot_danger(const ObjectPool* enemies, const int x, const int y) {
+	long long danger = 0;
+	for (size_t i = 0; i < enemies->count; ++i) {
+		int x_first, x_last, y_first, y_last;
+		if (!bot_axis(enemies->x[i], enemies->vx[i], x - ENEMY_WIDTH - BOT_MARGIN, x + PLAYER_WIDTH + BOT_MARGIN, &x_first, &x_last) ||
+			!bot_axis(enemies->y[i], enemies->vy[i], y - ENEMY_HEIGHT - BOT_MARGIN, y + PLAYER_HEIGHT + BOT_MARGIN, &y_first, &y_last)) {
+			continue;
+		}
+
+		const int first = x_first > y_first ? x_first : y_first;
+		const int last = x_last < y_last ? x_last : y_last;
+		if (first <= last) {
+			const long long urgency = BOT_HORIZON + 1 - first;
+			danger += urgency * urgency;
+		}
+	}
+	return danger;
+}
+
+static int bot_clamp(const int value, const int low, const int high) {
+	return value < low ? low : value > high ? high : value;
+}
+
+/**
+ * @brief 子弹从 (x, y) 射出后，敌机 i 会运动到的横坐标。
+ */
+static int bot_intercept_x(const GameWorld* world, const size_t i, const int y) {
+	const ObjectPool* enemies = &world->pools[ENEMY];
+	const int closing = world->params.bullet_speed + enemies->vy[i];
+	const int distance = y - (enemies->y[i] + ENEMY_HEIGHT);
+	const int ticks = closing > 0 && distance > 0 ? distance / closing : 0;
+	return enemies->x[i] + enemies->vx[i] * ticks;
+}
+
+unsigned bot_input(const GameWorld* world) {
+	static const int directions[9][2] = {
+		{ 0, 0 }, { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 }, { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 }
+	};
+	static const unsigned direction_inputs[9] = {
+		0, INPUT_LEFT, INPUT_RIGHT, INPUT_UP, INPUT_DOWN,
+		INPUT_LEFT | INPUT_UP, INPUT_RIGHT | INPUT_UP, INPUT_LEFT | INPUT_DOWN, INPUT_RIGHT | INPUT_DOWN
+	};
+
+	const Object* player = world->player;
+	const ObjectPool* enemies = &world->pools[ENEMY];
+	const int speed = world->params.player_speed;
+	const int bullet_x = player->x + PLAYER_WIDTH / 2 - BULLET_WIDTH / 2;
+
+	// 目标：玩家上方最低的（最先到达的）一架敌机；同时检查现在开火能否击中某一架。
+	int target_x = (SCREEN_WIDTH - PLAYER_WIDTH) / 2;
+	int target_y = INT_MIN;
+	bool aimed = false;
+	for (size_t i = 0; i < enemies->count; ++i) {
+		if (enemies->y[i] + ENEMY_HEIGHT > player->y) {
+			continue;
+		}
+
+		const int x = bot_intercept_x(world, i, player->y);
+		if (x < bullet_x + BULLET_WIDTH && x + ENEMY_WIDTH > bullet_x) {
+			aimed = true;
+		}
+		if (enemies->y[i] > target_y) {
+			target_y = enemies->y[i];
+			target_x = x + ENEMY_WIDTH / 2 - PLAYER_WIDTH / 2;
+		}
+	}
+	target_x = bot_clamp(target_x, 0, SCREEN_WIDTH - PLAYER_WIDTH);
+	const int home_y = SCREEN_HEIGHT - PLAYER_HEIGHT - BOT_HOME_OFFSET;
+
+	unsigned input = 0;
+	long long best = LLONG_MAX;
+	for (int d = 0; d < 9; ++d) {
+		// 第一个 tick 之后的位置与连续移动 BOT_LOOKAHEAD 个 tick 之后的位置都须安全。
+		const int x1 = bot_clamp(player->x + directions[d][0] * speed, 0, SCREEN_WIDTH - PLAYER_WIDTH);
+		const int y1 = bot_clamp(player->y + directions[d][1] * speed, 0, SCREEN_HEIGHT - PLAYER_HEIGHT);
+		const int xn = bot_clamp(player->x + directions[d][0] * speed * BOT_LOOKAHEAD, 0, SCREEN_WIDTH - PLAYER_WIDTH);
+		const int yn = bot_clamp(player->y + directions[d][1] * speed * BOT_LOOKAHEAD, 0, SCREEN_HEIGHT - PLAYER_HEIGHT);
+		const long long danger = bot_danger(enemies, x1, y1) * 4 + bot_danger(enemies, xn, yn);
+
+		const int dx = x1 - target_x;
+		const int dy = y1 - home_y;
+		const long long cost = danger * 1000 + (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy) / 4;
+		if (cost < best) {
+			best = cost;
+			input = direction_inputs[d];
+		}
+	}
+
+	if (world_can_fire(world) && (aimed || world->params.bullets_per_shot > 1)) {
+		input |= INPUT_FIRE;
+	}
+	return input;
+}
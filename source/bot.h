@@ -0,0 +1,35 @@
+/**
+ * @file bot.h
+ * @brief 这份头文件声明了自动驾驶的玩家。它只读取模拟状态中的敌机位置与速度，输出与键盘相同的输入位掩码：
+ *        躲避将要撞上的敌机，移动到最近的敌机下方；开火间隔允许、且现在开火能击中某架敌机时开火，一次射出多颗子弹时只要间隔允许就开火。用于无人值守的长时间稳定性测试与性能测试。
+ *        同样的模拟状态总是得到同样的输入，因此机器人玩的一局也可以录像并逐位一致地回放。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include "world.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef BOT_H
+#define BOT_H
+
+#define BOT_HORIZON 40 // 预测敌机运动的 tick 数
+#define BOT_LOOKAHEAD 6 // 评估一个移动方向时，假设沿这个方向连续移动的 tick 数
+#define BOT_MARGIN 6 // 躲避时在玩家四周额外留出的距离，单位：像素
+#define BOT_HOME_OFFSET 120 // 没有危险时玩家停留的位置距窗口底部的距离，单位：像素
+
+	/**
+	 * @brief 根据当前的模拟状态决定下一个 tick 的输入。
+	 * @return InputBit 的组合。
+	 */
+	unsigned bot_input(const GameWorld* world);
+
+#endif /* BOT_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
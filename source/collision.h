@@ -0,0 +1,59 @@
+/**
+ * @file collision.h
+ * @brief 这份头文件声明了批量 AABB 碰撞判断函数：用一个矩形同时与一组打包存放坐标的同尺寸矩形做判断，返回命中位掩码。
+ *        编译器开启 SSE2 / AVX2 时 collision_batch() 会自动选用对应的 SIMD 实现，否则退化为标量实现。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#if defined(__AVX2__)
+#define COLLISION_HAVE_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_HAVE_SSE2 1
+#endif
+
+	/**
+	 * @brief 命中位掩码所需的 uint32_t 个数。
+	 */
+#define COLLISION_MASK_WORDS(count) (((count) + 31) / 32)
+
+	/**
+	 * @brief 判断矩形 (x, y, width, height) 与 count 个宽高均为 (item_width, item_height)、左上角为 (xs[i], ys[i]) 的矩形是否相交。
+	 *        第 i 个矩形相交时，hit_mask[i / 32] 的第 i % 32 位为 1；hit_mask 的全部 COLLISION_MASK_WORDS(count) 个元素都会被写入。
+	 * @return 相交的矩形数量。
+	 */
+	size_t collision_batch(const int x, const int y, const int width, const int height,
+		const int* xs, const int* ys, const size_t count, const int item_width, const int item_height, uint32_t* hit_mask);
+
+	// 以下为各个具体实现，参数与返回值同 collision_batch()，可用于验证各实现的结果是否一致。
+
+	size_t collision_batch_scalar(const int x, const int y, const int width, const int height,
+		const int* xs, const int* ys, const size_t count, const int item_width, const int item_height, uint32_t* hit_mask);
+
+#ifdef COLLISION_HAVE_SSE2
+	size_t collision_batch_sse2(const int x, const int y, const int width, const int height,
+		const int* xs, const int* ys, const size_t count, const int item_width, const int item_height, uint32_t* hit_mask);
+#endif
+
+#ifdef COLLISION_HAVE_AVX2
+	size_t collision_batch_avx2(const int x, const int y, const int width, const int height,
+		const int* xs, const int* ys, const size_t count, const int item_width, const int item_height, uint32_t* hit_mask);
+#endif
+
+#endif /* COLLISION_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -7,60 +7,60 @@
  */
 
 #include "control.h"
-#include <stdio.h>
+#include "log.h"
 #include <stdbool.h>
 
 void game_control_to_menu(GameControlData* game_control_data) {
 	game_control_data->state = MENU;
-	fprintf(stdout, "Switching to main menu.\n");
+	LOG_INFO("Switching to main menu.");
 }
 
 void game_control_to_settings(GameControlData* game_control_data) {
 	game_control_data->state = SETTINGS;
-	fprintf(stdout, "Switching to settings.\n");
+	LOG_INFO("Switching to settings.");
 }
 
 void game_control_start(GameControlData* game_control_data, const int starting_hp) {
 	if (game_control_data->state == PLAYING) {
-		fprintf(stderr, "Attempting to start the game when the game is running.\n");
+		LOG_WARN("Attempting to start the game when the game is running.");
 	}
 
 	game_control_data->hp = starting_hp;
 	game_control_data->score = 0;
 	game_control_data->state = PLAYING;
-	fprintf(stdout, "Game started.\n");
+	LOG_INFO("Game started.");
 }
 
 void game_control_pause(GameControlData* game_control_data) {
 	if (game_control_data->state != PLAYING) {
-		fprintf(stderr, "Attempting to pause the game when the game is not running.\n");
+		LOG_WARN("Attempting to pause the game when the game is not running.");
 		return;
 	}
 
 	game_control_data->state = PAUSED;
-	fprintf(stdout, "Game paused.\n");
+	LOG_INFO("Game paused.");
 }
 
 void game_control_resume(GameControlData* game_control_data) {
 	if (game_control_data->state != PAUSED) {
-		fprintf(stderr, "Attempting to resume the game when the game hasn't been paused.\n");
+		LOG_WARN("Attempting to resume the game when the game hasn't been paused.");
 		return;
 	}
 
 	game_control_data->state = PLAYING;
-	fprintf(stdout, "Game resumed.\n");
+	LOG_INFO("Game resumed.");
 }
 
 void game_control_end(GameControlData* game_control_data) {
 	game_control_data->state = GAMEOVER;
-	fprintf(stdout, "Game over.\n");
-	fprintf(stdout, "Final score: %d\n", game_control_data->score);
+	LOG_INFO("Game over.");
+	LOG_INFO("Final score: %d", game_control_data->score);
 }
 
 void game_control_add_score(GameControlData* game_control_data, const int points) {
 	game_control_data->score += points;
-	fprintf(stdout, "Score +%d\n", points);
-	fprintf(stdout, "Total score now: %d\n", game_control_data->score);
+	LOG_DEBUG("Score +%d", points);
+	LOG_DEBUG("Total score now: %d", game_control_data->score);
 }
 
 /**
@@ -68,12 +68,12 @@ void game_control_add_score(GameControlData* game_control_data, const int points
  */
 void game_control_reduce_hp(GameControlData* game_control_data, const int delta) {
 	if (game_control_data->hp <= 0) {
-		fprintf(stderr, "Attempting to reduce hp when hp is not positive.\n");
+		LOG_WARN("Attempting to reduce hp when hp is not positive.");
 		return;
 	}
 
 	game_control_data->hp -= delta;
-	fprintf(stdout, "HP reduce by!\nCurrent HP: %d\n", game_control_data->hp);
+	LOG_INFO("HP reduced by %d. Current HP: %d", delta, game_control_data->hp);
 
 	if (game_control_data->hp <= 0) {
 		game_control_end(game_control_data);
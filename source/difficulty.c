@@ -0,0 +1,346 @@
+/**
+ * @file difficulty.c
+ * @brief 这份源文件定义了各难度的参数表与波次表，并实现了描述文件的解析与重新加载。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "difficulty.h"
+#include "log.h"
+
+#define DIFFICULTY_FIELDS 7 // difficulty 行必须给出的参数数
+
+const wchar_t* const difficulty_names[DIFFICULTY_COUNT] = DIFFICULTY_TABLE_NAMES;
+DIFFICULTY_CONST int starting_hp[DIFFICULTY_COUNT] = DIFFICULTY_TABLE_STARTING_HP;
+DIFFICULTY_CONST int delta_hp[DIFFICULTY_COUNT] = DIFFICULTY_TABLE_DELTA_HP;
+DIFFICULTY_CONST double min_fire_gap[DIFFICULTY_COUNT] = DIFFICULTY_TABLE_MIN_FIRE_GAP; // 单位：秒
+DIFFICULTY_CONST double min_enemy_spawn_gap[DIFFICULTY_COUNT] = DIFFICULTY_TABLE_MIN_ENEMY_SPAWN_GAP; // 单位：秒
+DIFFICULTY_CONST int player_speed[DIFFICULTY_COUNT] = DIFFICULTY_TABLE_PLAYER_SPEED; // 单位：像素每 tick
+DIFFICULTY_CONST int enemy_speed[DIFFICULTY_COUNT] = DIFFICULTY_TABLE_ENEMY_SPEED; // 单位：像素每 tick
+DIFFICULTY_CONST int bullet_speed[DIFFICULTY_COUNT] = DIFFICULTY_TABLE_BULLET_SPEED; // 单位：像素每 tick
+DIFFICULTY_CONST Wave difficulty_waves[DIFFICULTY_MAX_WAVES] = DIFFICULTY_TABLE_WAVES;
+DIFFICULTY_CONST size_t difficulty_wave_count = DIFFICULTY_TABLE_WAVE_COUNT;
+
+/**
+ * @brief 从 *cursor 开始取下一个以空白分隔的记号，并把它的结尾改为 '\0'。
+ * @return 没有更多记号时返回 NULL。
+ */
+static char* next_token(char** cursor) {
+	char* begin = *cursor;
+	while (*begin == ' ' || *begin == '\t') {
+		++begin;
+	}
+	if (*begin == '\0') {
+		*cursor = begin;
+		return NULL;
+	}
+
+	char* end = begin;
+	while (*end != '\0' && *end != ' ' && *end != '\t') {
+		++end;
+	}
+	*cursor = *end != '\0' ? end + 1 : end;
+	*end = '\0';
+	return begin;
+}
+
+static bool parse_int(const char* text, int* value) {
+	char* end = NULL;
+	const long parsed = strtol(text, &end, 10);
+	if (end == text || *end != '\0' || parsed < -1000000 || parsed > 1000000) {
+		return false;
+	}
+	*value = (int)parsed;
+	return true;
+}
+
+static bool parse_double(const char* text, double* value) {
+	char* end = NULL;
+	const double parsed = strtod(text, &end);
+	if (end == text || *end != '\0' || !(parsed >= 0 && parsed <= 1e6)) {
+		return false;
+	}
+	*value = parsed;
+	return true;
+}
+
+static int find_difficulty(const DifficultyConfig* config, const char* name) {
+	for (size_t i = 0; i < config->difficulty_count; ++i) {
+		if (!strcmp(config->names[i], name)) {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief 解析一行 difficulty。
+ * @return 出错时返回错误原因，否则返回 NULL。
+ */
+static const char* parse_difficulty(DifficultyConfig* config, char* cursor) {
+	const char* name = next_token(&cursor);
+	if (!name) {
+		return "missing difficulty name";
+	}
+	if (strlen(name) >= DIFFICULTY_NAME_SIZE) {
+		return "difficulty name is too long";
+	}
+	if (find_difficulty(config, name) >= 0) {
+		return "duplicate difficulty name";
+	}
+	if (config->difficulty_count == DIFFICULTY_MAX) {
+		return "too many difficulties";
+	}
+
+	const size_t index = config->difficulty_count;
+	unsigned fields = 0;
+	for (char* token = next_token(&cursor); token; token = next_token(&cursor)) {
+		char* value = strchr(token, '=');
+		if (!value) {
+			return "expected key=value";
+		}
+		*value++ = '\0';
+
+		bool ok;
+		unsigned field;
+		if (!strcmp(token, "starting_hp")) {
+			ok = parse_int(value, &config->starting_hp[index]) && config->starting_hp[index] > 0;
+			field = 1 << 0;
+		}
+		else if (!strcmp(token, "delta_hp")) {
+			ok = parse_int(value, &config->delta_hp[index]) && config->delta_hp[index] >= 0;
+			field = 1 << 1;
+		}
+		else if (!strcmp(token, "min_fire_gap")) {
+			ok = parse_double(value, &config->min_fire_gap[index]);
+			field = 1 << 2;
+		}
+		else if (!strcmp(token, "min_enemy_spawn_gap")) {
+			ok = parse_double(value, &config->min_enemy_spawn_gap[index]);
+			field = 1 << 3;
+		}
+		else if (!strcmp(token, "player_speed")) {
+			ok = parse_int(value, &config->player_speed[index]) && config->player_speed[index] > 0;
+			field = 1 << 4;
+		}
+		else if (!strcmp(token, "enemy_speed")) {
+			ok = parse_int(value, &config->enemy_speed[index]) && config->enemy_speed[index] > 0;
+			field = 1 << 5;
+		}
+		else if (!strcmp(token, "bullet_speed")) {
+			ok = parse_int(value, &config->bullet_speed[index]) && config->bullet_speed[index] > 0;
+			field = 1 << 6;
+		}
+		else {
+			return "unknown difficulty parameter";
+		}
+
+		if (!ok) {
+			return "invalid value";
+		}
+		fields |= field;
+	}
+
+	if (fields != (1u << DIFFICULTY_FIELDS) - 1) {
+		return "every difficulty needs all seven parameters";
+	}
+	memcpy(config->names[index], name, strlen(name) + 1);
+	++config->difficulty_count;
+	return NULL;
+}
+
+/**
+ * @brief 解析一行 wave。未给出的参数沿用同一难度的上一波，没有上一波时沿用难度本身的参数。
+ * @return 出错时返回错误原因，否则返回 NULL。
+ */
+static const char* parse_wave(DifficultyConfig* config, char* cursor) {
+	const char* name = next_token(&cursor);
+	if (!name) {
+		return "missing difficulty name";
+	}
+	const int difficulty = find_difficulty(config, name);
+	if (difficulty < 0) {
+		return "wave refers to a difficulty that has not been defined above";
+	}
+	if (config->wave_count == DIFFICULTY_MAX_WAVES) {
+		return "too many waves";
+	}
+
+	Wave wave = { difficulty, -1, config->min_enemy_spawn_gap[difficulty], 1, config->enemy_speed[difficulty] };
+	double previous_at = 0;
+	for (size_t i = config->wave_count; i-- > 0;) {
+		if (config->waves[i].difficulty == difficulty) {
+			wave = config->waves[i];
+			previous_at = wave.at;
+			wave.at = -1;
+			break;
+		}
+	}
+
+	for (char* token = next_token(&cursor); token; token = next_token(&cursor)) {
+		char* value = strchr(token, '=');
+		if (!value) {
+			return "expected key=value";
+		}
+		*value++ = '\0';
+
+		bool ok;
+		if (!strcmp(token, "at")) {
+			ok = parse_double(value, &wave.at);
+		}
+		else if (!strcmp(token, "min_enemy_spawn_gap")) {
+			ok = parse_double(value, &wave.min_enemy_spawn_gap);
+		}
+		else if (!strcmp(token, "enemies_per_spawn")) {
+			ok = parse_int(value, &wave.enemies_per_spawn) && wave.enemies_per_spawn > 0;
+		}
+		else if (!strcmp(token, "enemy_speed")) {
+			ok = parse_int(value, &wave.enemy_speed) && wave.enemy_speed > 0;
+		}
+		else {
+			return "unknown wave parameter";
+		}
+
+		if (!ok) {
+			return "invalid value";
+		}
+	}
+
+	if (wave.at < 0) {
+		return "every wave needs at=<seconds>";
+	}
+	if (wave.at < previous_at) {
+		return "waves of the same difficulty must be in time order";
+	}
+	config->waves[config->wave_count++] = wave;
+	return NULL;
+}
+
+bool difficulty_parse(DifficultyConfig* config, const char* text, char* error, const size_t error_size) {
+	memset(config, 0, sizeof(*config));
+
+	const size_t length = strlen(text);
+	char* copy = (char*)malloc(length + 1);
+	if (!copy) {
+		fprintf(stderr, "malloc() failed.\n");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(copy, text, length + 1);
+
+	const char* reason = NULL;
+	int line_number = 0;
+	char* line = copy;
+	while (line && !reason) {
+		++line_number;
+		char* next = strchr(line, '\n');
+		if (next) {
+			*next++ = '\0';
+		}
+
+		// 去掉注释与行尾的 '\r'。
+		char* comment = strchr(line, '#');
+		if (comment) {
+			*comment = '\0';
+		}
+		char* cr = strchr(line, '\r');
+		if (cr) {
+			*cr = '\0';
+		}
+
+		char* cursor = line;
+		const char* keyword = next_token(&cursor);
+		if (keyword && !strcmp(keyword, "difficulty")) {
+			reason = parse_difficulty(config, cursor);
+		}
+		else if (keyword && !strcmp(keyword, "wave")) {
+			reason = parse_wave(config, cursor);
+		}
+		else if (keyword) {
+			reason = "expected difficulty or wave";
+		}
+		line = next;
+	}
+	free(copy);
+
+	if (!reason && config->difficulty_count == 0) {
+		reason = "no difficulty defined";
+		line_number = 0;
+	}
+	if (reason) {
+		if (error && error_size) {
+			snprintf(error, error_size, "line %d: %s", line_number, reason);
+		}
+		return false;
+	}
+	return true;
+}
+
+#if DIFFICULTY_HOT_RELOAD
+static FILE* difficulty_open_file(const char* path) {
+#if defined(_MSC_VER)
+	FILE* file = NULL;
+	return fopen_s(&file, path, "rb") == 0 ? file : NULL;
+#else
+	return fopen(path, "rb");
+#endif
+}
+#endif
+
+bool difficulty_reload(const char* path) {
+#if DIFFICULTY_HOT_RELOAD
+	FILE* file = difficulty_open_file(path);
+	if (!file) {
+		LOG_WARN("Failed to open difficulty file %s.", path);
+		return false;
+	}
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	char* text = (char*)malloc(size > 0 ? (size_t)size + 1 : 1);
+	if (!text) {
+		fprintf(stderr, "malloc() failed.\n");
+		exit(EXIT_FAILURE);
+	}
+	const bool read = size >= 0 && fread(text, 1, (size_t)size, file) == (size_t)size;
+	fclose(file);
+	text[read ? size : 0] = '\0';
+
+	// 描述文件较大，不放在栈上。
+	static DifficultyConfig config;
+	char error[128];
+	const bool parsed = read && difficulty_parse(&config, text, error, sizeof(error));
+	free(text);
+	if (!parsed) {
+		LOG_WARN("Failed to reload difficulty file %s: %s", path, read ? error : "read error");
+		return false;
+	}
+	if (config.difficulty_count != DIFFICULTY_COUNT) {
+		LOG_WARN("Difficulty file %s defines %zu difficulties, but this build has %d. Regenerate difficulty_table.h and rebuild.",
+			path, config.difficulty_count, DIFFICULTY_COUNT);
+		return false;
+	}
+
+	for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
+		starting_hp[i] = config.starting_hp[i];
+		delta_hp[i] = config.delta_hp[i];
+		min_fire_gap[i] = config.min_fire_gap[i];
+		min_enemy_spawn_gap[i] = config.min_enemy_spawn_gap[i];
+		player_speed[i] = config.player_speed[i];
+		enemy_speed[i] = config.enemy_speed[i];
+		bullet_speed[i] = config.bullet_speed[i];
+	}
+	memcpy(difficulty_waves, config.waves, sizeof(Wave) * config.wave_count);
+	difficulty_wave_count = config.wave_count;
+
+	LOG_INFO("Reloaded difficulty file %s: %zu waves.", path, config.wave_count);
+	return true;
+#else
+	LOG_WARN("Cannot reload %s: build with DIFFICULTY_HOT_RELOAD=1 to tune difficulties at run time.", path);
+	return false;
+#endif
+}
@@ -0,0 +1,101 @@
+/**
+ * @file difficulty.h
+ * @brief 这份头文件声明了各难度的参数表与波次表。参数表由 bench/difficulty_gen.cpp 根据描述文件 difficulty.cfg
+ *        离线生成（difficulty_table.h），发布版本中都是编译期常量，查表没有额外开销。
+ *        以 DIFFICULTY_HOT_RELOAD=1 编译的调参版本可以在运行时重新加载描述文件。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <wchar.h>
+#include "difficulty_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef DIFFICULTY_H
+#define DIFFICULTY_H
+
+#ifndef DIFFICULTY_HOT_RELOAD
+#define DIFFICULTY_HOT_RELOAD 0 // 为 1 时参数表可以在运行时重新加载，仅用于调参
+#endif
+
+#if DIFFICULTY_HOT_RELOAD
+#define DIFFICULTY_CONST
+#else
+#define DIFFICULTY_CONST const
+#endif
+
+#define DIFFICULTY_FILE "difficulty.cfg"
+#define DIFFICULTY_MAX 16 // 描述文件中最多的难度数
+#define DIFFICULTY_MAX_WAVES 64 // 描述文件中最多的波次数
+#define DIFFICULTY_NAME_SIZE 32 // 难度名称（UTF-8）最多的字节数，含结尾的 '\0'
+
+	// difficulty_table.h 由描述文件生成，按钮、最高分等按难度个数分配的数组都依赖这一范围。
+	static_assert(DIFFICULTY_COUNT >= 1 && DIFFICULTY_COUNT <= DIFFICULTY_MAX, "DIFFICULTY_COUNT out of range");
+
+	/**
+	 * @brief 一波：一局开始 at 秒后起，敌机的生成参数改为下列的值。
+	 */
+	typedef struct Wave {
+		int difficulty;
+		double at; // 单位：秒
+		double min_enemy_spawn_gap; // 单位：秒
+		int enemies_per_spawn;
+		int enemy_speed; // 单位：像素每 tick
+	} Wave;
+
+	/**
+	 * @brief 解析描述文件得到的全部内容。
+	 */
+	typedef struct DifficultyConfig {
+		size_t difficulty_count;
+		char names[DIFFICULTY_MAX][DIFFICULTY_NAME_SIZE];
+		int starting_hp[DIFFICULTY_MAX];
+		int delta_hp[DIFFICULTY_MAX];
+		double min_fire_gap[DIFFICULTY_MAX];
+		double min_enemy_spawn_gap[DIFFICULTY_MAX];
+		int player_speed[DIFFICULTY_MAX];
+		int enemy_speed[DIFFICULTY_MAX];
+		int bullet_speed[DIFFICULTY_MAX];
+		size_t wave_count;
+		Wave waves[DIFFICULTY_MAX_WAVES]; // 同一难度的各波按时间先后排列
+	} DifficultyConfig;
+
+	// 各难度下的游戏参数。
+	extern const wchar_t* const difficulty_names[DIFFICULTY_COUNT];
+	extern DIFFICULTY_CONST int starting_hp[DIFFICULTY_COUNT];
+	extern DIFFICULTY_CONST int delta_hp[DIFFICULTY_COUNT];
+	extern DIFFICULTY_CONST double min_fire_gap[DIFFICULTY_COUNT]; // 单位：秒
+	extern DIFFICULTY_CONST double min_enemy_spawn_gap[DIFFICULTY_COUNT]; // 单位：秒
+	extern DIFFICULTY_CONST int player_speed[DIFFICULTY_COUNT]; // 单位：像素每 tick
+	extern DIFFICULTY_CONST int enemy_speed[DIFFICULTY_COUNT]; // 单位：像素每 tick
+	extern DIFFICULTY_CONST int bullet_speed[DIFFICULTY_COUNT]; // 单位：像素每 tick
+
+	// 所有难度的波次，同一难度的各波按时间先后排列。
+	extern DIFFICULTY_CONST Wave difficulty_waves[DIFFICULTY_MAX_WAVES];
+	extern DIFFICULTY_CONST size_t difficulty_wave_count;
+
+	/**
+	 * @brief 解析描述文件的内容。
+	 * @return 格式错误时返回 false，并把出错的行号与原因写入 error。
+	 */
+	bool difficulty_parse(DifficultyConfig* config, const char* text, char* error, const size_t error_size);
+
+	/**
+	 * @brief 重新加载描述文件，更新参数表与波次表，下一局开始时生效。难度的数量与名称在编译时确定，不能改变。
+	 *        只有以 DIFFICULTY_HOT_RELOAD=1 编译时可用。
+	 * @return 是否加载成功。失败时参数表保持不变。
+	 */
+	bool difficulty_reload(const char* path);
+
+#endif /* DIFFICULTY_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,23 @@
+/**
+ * @file difficulty_table.h
+ * @brief 各难度的参数表与波次表，由 bench/difficulty_gen.cpp 根据 difficulty.cfg 生成，请勿手动修改。
+ *        各宏只在 difficulty.c 中用来初始化参数表，DIFFICULTY_COUNT 决定最高分文件中记录的难度数。
+ */
+
+#ifndef DIFFICULTY_TABLE_H
+#define DIFFICULTY_TABLE_H
+
+#define DIFFICULTY_COUNT 3
+#define DIFFICULTY_TABLE_NAMES { L"\u7B80\u5355", L"\u666E\u901A", L"\u56F0\u96BE" }
+#define DIFFICULTY_TABLE_STARTING_HP { 2, 2, 1 }
+#define DIFFICULTY_TABLE_DELTA_HP { 1, 1, 1 }
+#define DIFFICULTY_TABLE_MIN_FIRE_GAP { 0.4, 0.5, 0.6 }
+#define DIFFICULTY_TABLE_MIN_ENEMY_SPAWN_GAP { 0.3, 0.2, 0.1 }
+#define DIFFICULTY_TABLE_PLAYER_SPEED { 8, 12, 12 }
+#define DIFFICULTY_TABLE_ENEMY_SPEED { 6, 9, 9 }
+#define DIFFICULTY_TABLE_BULLET_SPEED { 12, 18, 18 }
+
+#define DIFFICULTY_TABLE_WAVE_COUNT 0
+#define DIFFICULTY_TABLE_WAVES { { 0 } }
+
+#endif /* DIFFICULTY_TABLE_H */
@@ -0,0 +1,100 @@
+/**
+ * @file framebuffer.h
+ * @brief 这份头文件声明了与平台无关的软件帧缓冲区与精灵合成函数。像素是与 EasyX 图像缓冲区相同的 32 位 0xAARRGGBB，
+ *        精灵使用预乘 alpha，混合内核有标量、SSE2 与 AVX2 版本，结果逐位一致。
+ *        渲染器可以直接把窗口的图像缓冲区当作合成目标，整帧合成完毕后只提交一次；无窗口时也可以合成到自己分配的缓冲区并计算哈希值。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "collision.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#define FRAMEBUFFER_BACKGROUND_COLOR 0xFF050F28u // 没有背景图时的底色，与 EasyX 后端的 RGB(5, 15, 40) 相同
+
+	/**
+	 * @brief 一块像素：可以是自己分配的图像，也可以是别处图像中的一个子矩形。stride 是相邻两行的间隔，单位：像素。
+	 */
+	typedef struct FramebufferImage {
+		uint32_t* pixels;
+		int width, height;
+		int stride;
+	} FramebufferImage;
+
+	/**
+	 * @brief 合成一帧游戏画面所需的精灵。pixels 为 NULL 的精灵不绘制。除背景外都须预乘 alpha。
+	 */
+	typedef struct FramebufferSprites {
+		FramebufferImage background;
+		FramebufferImage player;
+		FramebufferImage enemy;
+		FramebufferImage bullet;
+	} FramebufferSprites;
+
+	/**
+	 * @brief 分配一块 width * height 的图像，像素初始为 0。
+	 */
+	void framebuffer_init(FramebufferImage* image, const int width, const int height);
+
+	/**
+	 * @brief 释放 framebuffer_init() 分配的图像。
+	 */
+	void framebuffer_free(FramebufferImage* image);
+
+	/**
+	 * @brief 取 image 中的一个子矩形，不复制像素。矩形须在 image 之内。
+	 */
+	FramebufferImage framebuffer_view(const FramebufferImage* image, const int x, const int y, const int width, const int height);
+
+	/**
+	 * @brief 把 src 复制为一块新分配的图像，并把 RGB 乘以 alpha。
+	 */
+	void framebuffer_premultiply(FramebufferImage* dst, const FramebufferImage* src);
+
+	/**
+	 * @brief 用 color 填充整块图像。
+	 */
+	void framebuffer_fill(FramebufferImage* target, const uint32_t color);
+
+	/**
+	 * @brief 把 src 不透明地复制到 target 的 (x, y) 处，超出 target 的部分被裁剪。
+	 */
+	void framebuffer_copy(FramebufferImage* target, const FramebufferImage* src, const int x, const int y);
+
+	/**
+	 * @brief 把预乘 alpha 的 src 混合到 target 的 (x, y) 处：target = src + target * (255 - src.alpha) / 255，
+	 *        超出 target 的部分被裁剪。target 的 alpha 通道随之混合，但窗口不使用它。
+	 */
+	void framebuffer_blend(FramebufferImage* target, const FramebufferImage* src, const int x, const int y);
+
+	// 以下为 framebuffer_blend() 逐行使用的混合内核：dst[i] = src[i] + dst[i] * (255 - src[i].alpha) / 255，可用于验证各实现的结果是否一致。
+
+	void framebuffer_blend_row_scalar(uint32_t* dst, const uint32_t* src, const int count);
+
+#ifdef COLLISION_HAVE_SSE2
+	void framebuffer_blend_row_sse2(uint32_t* dst, const uint32_t* src, const int count);
+#endif
+
+#ifdef COLLISION_HAVE_AVX2
+	void framebuffer_blend_row_avx2(uint32_t* dst, const uint32_t* src, const int count);
+#endif
+
+	/**
+	 * @brief 计算图像像素的哈希值（FNV-1a），用于无窗口的逐位一致测试。
+	 */
+	uint64_t framebuffer_hash(const FramebufferImage* image);
+
+#endif /* FRAMEBUFFER_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,201 @@
+/**
+ * @file glyph_cache.c
+ * @brief 这份源文件实现了字形缓存与文字排版缓存。字形按键值存放在开放寻址的散列表中，像素逐行摆放在一张图集里；
+ *        散列表或图集放满时清空整个缓存，并把代数加一，使所有旧的排版作废。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "glyph_cache.h"
+
+#define GLYPH_CODEPOINT_MASK 0xFFFFF
+#define GLYPH_REPLACEMENT L'?' // 超出 GLYPH_CODEPOINT_MASK 的字符用它代替
+
+static inline uint32_t glyph_style(const int font, const int size) {
+	return (uint32_t)(font & (GLYPH_MAX_FONTS - 1)) << 8 | (uint32_t)(size & GLYPH_MAX_SIZE);
+}
+
+/**
+ * @brief 字形的键值：颜色、字体、字号与字符，最高位恒为 1，以区别于空位。
+ */
+static inline uint64_t glyph_key(const uint32_t style, const uint32_t color, const uint32_t codepoint) {
+	return 1ULL << 63 | (uint64_t)(color & 0xFFFFFF) << 32 | (uint64_t)style << 20 | (codepoint & GLYPH_CODEPOINT_MASK);
+}
+
+static inline size_t glyph_slot(uint64_t key) {
+	key ^= key >> 33;
+	key *= 0xFF51AFD7ED558CCDULL;
+	key ^= key >> 33;
+	return (size_t)key & (GLYPH_SLOTS - 1);
+}
+
+static inline uint32_t div255(const uint32_t value) {
+	const uint32_t x = value + 128;
+	return (x + (x >> 8)) >> 8;
+}
+
+void glyph_cache_init(GlyphCache* cache, const GlyphRasterizer rasterize, void* context) {
+	memset(cache, 0, sizeof(*cache));
+	cache->rasterize = rasterize;
+	cache->context = context;
+	framebuffer_init(&cache->atlas, GLYPH_ATLAS_SIZE, GLYPH_ATLAS_SIZE);
+	cache->glyphs = (Glyph*)calloc(GLYPH_SLOTS, sizeof(Glyph));
+	cache->layouts = (GlyphLayout*)calloc(GLYPH_LAYOUT_SLOTS, sizeof(GlyphLayout));
+	if (!cache->glyphs || !cache->layouts) {
+		fprintf(stderr, "malloc() failed.\n");
+		exit(EXIT_FAILURE);
+	}
+	cache->generation = 1;
+}
+
+void glyph_cache_free(GlyphCache* cache) {
+	framebuffer_free(&cache->atlas);
+	free(cache->glyphs);
+	free(cache->layouts);
+	cache->glyphs = NULL;
+	cache->layouts = NULL;
+}
+
+void glyph_cache_clear(GlyphCache* cache) {
+	memset(cache->glyphs, 0, sizeof(Glyph) * GLYPH_SLOTS);
+	cache->glyph_count = 0;
+	cache->pen_x = cache->pen_y = cache->row_height = 0;
+	++cache->generation;
+}
+
+/**
+ * @brief 光栅化一个字形，预乘 alpha 后放入图集并插入散列表。空间不足时先清空缓存。
+ * @return 字形在散列表中的下标。
+ */
+static size_t glyph_insert(GlyphCache* cache, const uint64_t key, const int font, const int size, const uint32_t color, const uint32_t codepoint) {
+	GlyphBitmap bitmap = { 0 };
+	if (!cache->rasterize || !cache->rasterize(cache->context, font, size, codepoint, &bitmap) ||
+		bitmap.width < 0 || bitmap.height < 0 || bitmap.width > GLYPH_ATLAS_SIZE || bitmap.height > GLYPH_ATLAS_SIZE) {
+		bitmap.width = bitmap.height = bitmap.advance = 0;
+	}
+
+	if (cache->pen_x + bitmap.width > GLYPH_ATLAS_SIZE) {
+		cache->pen_x = 0;
+		cache->pen_y += cache->row_height;
+		cache->row_height = 0;
+	}
+	if (cache->pen_y + bitmap.height > GLYPH_ATLAS_SIZE || cache->glyph_count + 1 > GLYPH_SLOTS / 4 * 3) {
+		glyph_cache_clear(cache);
+	}
+
+	Glyph glyph = { key, cache->pen_x, cache->pen_y, bitmap.width, bitmap.height, bitmap.advance };
+	cache->pen_x += bitmap.width;
+	if (bitmap.height > cache->row_height) {
+		cache->row_height = bitmap.height;
+	}
+
+	const uint32_t r = color >> 16 & 0xFF, g = color >> 8 & 0xFF, b = color & 0xFF;
+	for (int y = 0; y < bitmap.height; ++y) {
+		const uint8_t* in = bitmap.coverage + (size_t)y * bitmap.stride;
+		uint32_t* out = cache->atlas.pixels + (size_t)(glyph.y + y) * cache->atlas.stride + glyph.x;
+		for (int x = 0; x < bitmap.width; ++x) {
+			const uint32_t a = in[x];
+			out[x] = a << 24 | div255(r * a) << 16 | div255(g * a) << 8 | div255(b * a);
+		}
+	}
+
+	size_t slot = glyph_slot(key);
+	while (cache->glyphs[slot].key) {
+		slot = (slot + 1) & (GLYPH_SLOTS - 1);
+	}
+	cache->glyphs[slot] = glyph;
+	++cache->glyph_count;
+	++cache->rasterized;
+	return slot;
+}
+
+static size_t glyph_lookup(GlyphCache* cache, const int font, const int size, const uint32_t color, uint32_t codepoint) {
+	if (codepoint > GLYPH_CODEPOINT_MASK) {
+		codepoint = GLYPH_REPLACEMENT;
+	}
+
+	const uint64_t key = glyph_key(glyph_style(font, size), color, codepoint);
+	for (size_t slot = glyph_slot(key); cache->glyphs[slot].key; slot = (slot + 1) & (GLYPH_SLOTS - 1)) {
+		if (cache->glyphs[slot].key == key) {
+			return slot;
+		}
+	}
+	return glyph_insert(cache, key, font, size, color, codepoint);
+}
+
+static uint64_t layout_hash(const uint32_t style, const uint32_t color, const wchar_t* text) {
+	uint64_t hash = 14695981039346656037ULL;
+	hash = (hash ^ style) * 1099511628211ULL;
+	hash = (hash ^ color) * 1099511628211ULL;
+	for (const wchar_t* c = text; *c; ++c) {
+		hash = (hash ^ (uint64_t)*c) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+const GlyphLayout* glyph_cache_layout(GlyphCache* cache, const int font, const int size, const uint32_t color, const wchar_t* text) {
+	const uint32_t style = glyph_style(font, size);
+	const uint64_t hash = layout_hash(style, color & 0xFFFFFF, text);
+	GlyphLayout* layout = &cache->layouts[hash % GLYPH_LAYOUT_SLOTS];
+	if (layout->generation == cache->generation && layout->hash == hash && layout->style == style &&
+		layout->color == (color & 0xFFFFFF) && !wcscmp(layout->text, text)) {
+		++cache->layout_hits;
+		return layout;
+	}
+	++cache->layout_misses;
+
+	// 排版中途缓存被清空时，之前取得的下标都已作废，在清空后的缓存中重新排一次。
+	for (int attempt = 0; attempt < 2; ++attempt) {
+		const unsigned generation = cache->generation;
+		int x = 0, height = 0;
+		size_t count = 0;
+		for (; count < GLYPH_LAYOUT_LENGTH && text[count]; ++count) {
+			const size_t slot = glyph_lookup(cache, font, size, color, (uint32_t)text[count]);
+			if (cache->generation != generation) {
+				break;
+			}
+
+			const Glyph* glyph = &cache->glyphs[slot];
+			layout->glyphs[count] = (uint16_t)slot;
+			layout->offsets[count] = x;
+			x += glyph->advance;
+			if (glyph->height > height) {
+				height = glyph->height;
+			}
+		}
+
+		layout->count = count;
+		layout->width = x;
+		layout->height = height;
+		if (cache->generation == generation) {
+			break;
+		}
+	}
+
+	memcpy(layout->text, text, sizeof(wchar_t) * layout->count);
+	layout->text[layout->count] = L'\0';
+	layout->hash = hash;
+	layout->generation = cache->generation;
+	layout->style = style;
+	layout->color = color & 0xFFFFFF;
+	return layout;
+}
+
+void glyph_cache_draw(const GlyphCache* cache, FramebufferImage* target, const GlyphLayout* layout, const int x, const int y) {
+	if (layout->generation != cache->generation) {
+		return;
+	}
+
+	for (size_t i = 0; i < layout->count; ++i) {
+		const Glyph* glyph = &cache->glyphs[layout->glyphs[i]];
+		if (glyph->width == 0 || glyph->height == 0) {
+			continue;
+		}
+		const FramebufferImage view = framebuffer_view(&cache->atlas, glyph->x, glyph->y, glyph->width, glyph->height);
+		framebuffer_blend(target, &view, x + layout->offsets[i], y);
+	}
+}
@@ -0,0 +1,109 @@
+/**
+ * @file glyph_cache.h
+ * @brief 这份头文件声明了与平台无关的字形缓存与文字排版缓存。
+ *        每个字形（字体、字号、颜色、字符）只光栅化一次，预乘 alpha 后存入一张图集，之后用 framebuffer_blend() 直接绘制；
+ *        排版缓存记住整段文字由哪些字形组成、各自的位置与总宽高，文字不变时既不查字形也不测量。
+ *        字形的光栅化由调用者提供的函数完成，例如 EasyX 后端用 GDI 绘制单个字符。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <wchar.h>
+#include "framebuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#define GLYPH_ATLAS_SIZE 1024 // 字形图集的宽与高，单位：像素。放满后清空整个缓存重新开始
+#define GLYPH_SLOTS 4096 // 字形散列表的容量，须为 2 的幂，最多装到 3/4
+#define GLYPH_LAYOUT_SLOTS 64 // 排版缓存的容量，直接映射
+#define GLYPH_LAYOUT_LENGTH 96 // 一段文字最多的字符数，超出的部分不绘制
+#define GLYPH_MAX_FONTS 16
+#define GLYPH_MAX_SIZE 255 // 字号的上限
+
+	/**
+	 * @brief 光栅化得到的一个字形：coverage 是每个像素的覆盖率（0 ~ 255），advance 是绘制下一个字符前前进的宽度。
+	 */
+	typedef struct GlyphBitmap {
+		const uint8_t* coverage;
+		int width, height;
+		int stride;
+		int advance;
+	} GlyphBitmap;
+
+	/**
+	 * @brief 光栅化一个字符。font 是调用者自己约定的字体编号。
+	 * @return 无法光栅化时返回 false，这个字符按宽度 0 处理。
+	 */
+	typedef bool (*GlyphRasterizer)(void* context, const int font, const int size, const uint32_t codepoint, GlyphBitmap* bitmap);
+
+	/**
+	 * @brief 缓存中的一个字形，以及它在图集中的位置。
+	 */
+	typedef struct Glyph {
+		uint64_t key; // 为 0 表示空位
+		int x, y;
+		int width, height;
+		int advance;
+	} Glyph;
+
+	/**
+	 * @brief 一段排好的文字。
+	 */
+	typedef struct GlyphLayout {
+		uint64_t hash;
+		unsigned generation; // 排版时缓存的代数，缓存清空后作废
+		uint32_t style; // 字体、字号与颜色
+		uint32_t color;
+		wchar_t text[GLYPH_LAYOUT_LENGTH + 1];
+		size_t count;
+		uint16_t glyphs[GLYPH_LAYOUT_LENGTH]; // 各字符在字形散列表中的下标
+		int offsets[GLYPH_LAYOUT_LENGTH]; // 各字符的横坐标
+		int width, height;
+	} GlyphLayout;
+
+	typedef struct GlyphCache {
+		GlyphRasterizer rasterize;
+		void* context;
+		FramebufferImage atlas;
+		int pen_x, pen_y, row_height; // 图集逐行摆放的位置
+		Glyph* glyphs;
+		size_t glyph_count;
+		GlyphLayout* layouts;
+		unsigned generation;
+		size_t rasterized; // 统计：光栅化的字形数
+		size_t layout_hits, layout_misses; // 统计：排版缓存的命中与未命中次数
+	} GlyphCache;
+
+	void glyph_cache_init(GlyphCache* cache, const GlyphRasterizer rasterize, void* context);
+	void glyph_cache_free(GlyphCache* cache);
+
+	/**
+	 * @brief 清空所有字形与排版。之前取得的 GlyphLayout 随之作废。
+	 */
+	void glyph_cache_clear(GlyphCache* cache);
+
+	/**
+	 * @brief 取得一段文字的排版，颜色为 0xRRGGBB。文字、字体、字号与颜色都与缓存中的相同时直接返回，否则重新排版，
+	 *        只有缓存中还没有的字形才会光栅化。返回的指针在下一次调用 glyph_cache_layout() 之前有效。
+	 */
+	const GlyphLayout* glyph_cache_layout(GlyphCache* cache, const int font, const int size, const uint32_t color, const wchar_t* text);
+
+	/**
+	 * @brief 把排好的文字绘制到 target，(x, y) 是文字的左上角。
+	 */
+	void glyph_cache_draw(const GlyphCache* cache, FramebufferImage* target, const GlyphLayout* layout, const int x, const int y);
+
+#endif /* GLYPH_CACHE_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,200 @@
+/**
+ * @file grid.c
+ * @brief 这份源文件实现了用于碰撞粗筛的均匀网格。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "grid.h"
+#include "jobs.h"
+
+static int clamp(const int value, const int low, const int high) {
+	return value < low ? low : (value > high ? high : value);
+}
+
+/**
+ * @brief 求横坐标 x 所在的列。先把坐标钳制到网格覆盖区域内再查表，既避免了除法，也把区域外的坐标归入最近的边缘格子。
+ */
+static int grid_col(const Grid* grid, const int x) {
+	return grid->col_of[clamp(x - grid->left, 0, grid->cols * grid->cell_width - 1)];
+}
+
+/**
+ * @brief 求纵坐标 y 所在的行，做法同 grid_col()。
+ */
+static int grid_row(const Grid* grid, const int y) {
+	return grid->row_of[clamp(y - grid->top, 0, grid->rows * grid->cell_height - 1)];
+}
+
+void grid_init(Grid* grid, const int left, const int top, const int width, const int height,
+	const int cell_width, const int cell_height, const int item_width, const int item_height, const size_t capacity, Arena* arena) {
+	grid->left = left;
+	grid->top = top;
+	grid->cell_width = cell_width;
+	grid->cell_height = cell_height;
+	grid->cols = (width + cell_width - 1) / cell_width;
+	grid->rows = (height + cell_height - 1) / cell_height;
+	grid->item_width = item_width;
+	grid->item_height = item_height;
+	grid->capacity = capacity;
+
+	if (grid->cols > GRID_MAX_COLS) {
+		fprintf(stderr, "Too many grid columns.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	grid->cell_start = (size_t*)arena_alloc(arena, sizeof(size_t) * ((size_t)grid->cols * grid->rows + 1));
+	grid->items = (size_t*)arena_alloc(arena, sizeof(size_t) * (capacity ? capacity : 1));
+	grid->item_cell = (int*)arena_alloc(arena, sizeof(int) * (capacity ? capacity : 1));
+	grid->item_x = (int*)arena_alloc(arena, sizeof(int) * (capacity ? capacity : 1));
+	grid->item_y = (int*)arena_alloc(arena, sizeof(int) * (capacity ? capacity : 1));
+	grid->row_mask = (uint64_t*)arena_alloc(arena, sizeof(uint64_t) * grid->rows);
+	grid->col_of = (int*)arena_alloc(arena, sizeof(int) * grid->cols * cell_width);
+	grid->row_of = (int*)arena_alloc(arena, sizeof(int) * grid->rows * cell_height);
+	grid->chunk_start = (size_t*)arena_alloc(arena, sizeof(size_t) * GRID_MAX_CHUNKS * grid->cols * grid->rows);
+	grid->chunk_row_mask = (uint64_t*)arena_alloc(arena, sizeof(uint64_t) * GRID_MAX_CHUNKS * grid->rows);
+
+	for (int x = 0; x < grid->cols * cell_width; ++x) {
+		grid->col_of[x] = x / cell_width;
+	}
+	for (int y = 0; y < grid->rows * cell_height; ++y) {
+		grid->row_of[y] = y / cell_height;
+	}
+}
+
+/**
+ * @brief 并行重建网格时一次调用的参数。
+ */
+typedef struct GridBuildJob {
+	Grid* grid;
+	const int* xs, * ys;
+} GridBuildJob;
+
+/**
+ * @brief 第一趟：统计第 chunk 块对象在每个格子中的数量，并记下每个对象所在的格子。
+ */
+static void grid_count_chunk(void* context, const size_t begin, const size_t end, const size_t chunk) {
+	const GridBuildJob* job = (const GridBuildJob*)context;
+	Grid* grid = job->grid;
+	const int cell_count = grid->cols * grid->rows;
+	size_t* counts = grid->chunk_start + chunk * cell_count;
+	uint64_t* row_mask = grid->chunk_row_mask + chunk * grid->rows;
+
+	for (int c = 0; c < cell_count; ++c) {
+		counts[c] = 0;
+	}
+	for (int r = 0; r < grid->rows; ++r) {
+		row_mask[r] = 0;
+	}
+
+	for (size_t i = begin; i < end; ++i) {
+		const int row = grid_row(grid, job->ys[i]), col = grid_col(grid, job->xs[i]);
+		const int cell = row * grid->cols + col;
+
+		row_mask[row] |= (uint64_t)1 << col;
+
+		grid->item_cell[i] = cell;
+		++counts[cell];
+	}
+}
+
+/**
+ * @brief 第二趟：按下标顺序把第 chunk 块的对象放入各自格子中属于这一块的写入位置。
+ */
+static void grid_scatter_chunk(void* context, const size_t begin, const size_t end, const size_t chunk) {
+	const GridBuildJob* job = (const GridBuildJob*)context;
+	Grid* grid = job->grid;
+	size_t* next = grid->chunk_start + chunk * grid->cols * grid->rows;
+
+	for (size_t i = begin; i < end; ++i) {
+		const size_t k = next[grid->item_cell[i]]++;
+		grid->items[k] = i;
+		grid->item_x[k] = job->xs[i];
+		grid->item_y[k] = job->ys[i];
+	}
+}
+
+/**
+ * @brief 用计数排序重建网格：各块分别统计每格对象数量，按「格子优先、块号其次」的顺序求前缀和，再由各块按下标顺序放入。
+ *        同一格子中块号小的对象排在前面，块内按下标顺序放入，因此每个格子中的对象仍按下标升序排列，与块数无关。
+ */
+void grid_build(Grid* grid, const int* xs, const int* ys, const size_t count) {
+	const int cell_count = grid->cols * grid->rows;
+	const size_t grain = jobs_grain(count, GRID_PARALLEL_GRAIN, GRID_MAX_CHUNKS);
+
+	GridBuildJob job;
+	job.grid = grid;
+	job.xs = xs;
+	job.ys = ys;
+	const size_t chunks = jobs_parallel_for(count, grain, grid_count_chunk, &job);
+
+	for (int r = 0; r < grid->rows; ++r) {
+		grid->row_mask[r] = 0;
+		for (size_t k = 0; k < chunks; ++k) {
+			grid->row_mask[r] |= grid->chunk_row_mask[k * grid->rows + r];
+		}
+	}
+
+	// 把各块的数量就地改写为各块在这个格子中的写入位置。
+	size_t start = 0;
+	for (int c = 0; c < cell_count; ++c) {
+		grid->cell_start[c] = start;
+		for (size_t k = 0; k < chunks; ++k) {
+			size_t* slot = grid->chunk_start + k * cell_count + c;
+			const size_t n = *slot;
+			*slot = start;
+			start += n;
+		}
+	}
+	grid->cell_start[cell_count] = start;
+
+	jobs_parallel_for(count, grain, grid_scatter_chunk, &job);
+}
+
+/**
+ * @brief 对象左上角落在 [x - item_width + 1, x + width - 1] × [y - item_height + 1, y + height - 1] 内时才可能与矩形相交，
+ *        返回覆盖这一范围的格子。由于边缘格子的归并是单调的，钳制后的范围仍包含所有可能相交的对象。
+ */
+void grid_query_range(const Grid* grid, const int x, const int y, const int width, const int height,
+	int* col_begin, int* col_end, int* row_begin, int* row_end) {
+	*col_begin = grid_col(grid, x - grid->item_width + 1);
+	*col_end = grid_col(grid, x + width - 1);
+	*row_begin = grid_row(grid, y - grid->item_height + 1);
+	*row_end = grid_row(grid, y + height - 1);
+}
+
+/**
+ * @brief 判断给定行列范围内是否所有格子都为空。
+ */
+bool grid_range_empty(const Grid* grid, const int col_begin, const int col_end, const int row_begin, const int row_end) {
+	// 第 col_begin 到 col_end 位为 1 的掩码；col_end 最大为 63，因此先移 col_end 位再移 1 位，避免移位 64 位。
+	const uint64_t cols = (((uint64_t)1 << col_end) << 1) - ((uint64_t)1 << col_begin);
+
+	uint64_t occupied = 0;
+	for (int row = row_begin; row <= row_end; ++row) {
+		occupied |= grid->row_mask[row];
+	}
+	return (occupied & cols) == 0;
+}
+
+void grid_free(Grid* grid) {
+	free(grid->cell_start);
+	free(grid->items);
+	free(grid->item_cell);
+	free(grid->item_x);
+	free(grid->item_y);
+	free(grid->col_of);
+	free(grid->row_of);
+	free(grid->row_mask);
+	free(grid->chunk_start);
+	free(grid->chunk_row_mask);
+	grid->col_of = grid->row_of = NULL;
+	grid->row_mask = grid->chunk_row_mask = NULL;
+	grid->chunk_start = NULL;
+	grid->cell_start = grid->items = NULL;
+	grid->item_cell = grid->item_x = grid->item_y = NULL;
+	grid->capacity = 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file grid.h
+ * @brief 这份头文件声明了用于碰撞粗筛（broadphase）的均匀网格。
+ *        每个 tick 将一类对象按左上角坐标放入网格，之后只需与查询区域附近格子中的对象做精确碰撞判断。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "object.h"
+#include "arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef GRID_H
+#define GRID_H
+
+#define GRID_MAX_COLS 64 // 网格列数上限，使每一行的占用情况能用一个 uint64_t 表示
+#define GRID_PARALLEL_GRAIN 8192 // 并行重建时每块至少包含的对象数
+#define GRID_MAX_CHUNKS 64 // 并行重建时的块数上限
+
+	/**
+	 * @brief 均匀网格。格子中的对象以下标形式按计数排序连续存放，重建时不分配内存。
+	 *        第 c 个格子中的对象为 items[cell_start[c]] 到 items[cell_start[c + 1] - 1]，且按下标升序排列。
+	 *        所有格子拼接起来恰好是全部对象，因此 item_x、item_y 整体也可用于不经粗筛的批量判断。
+	 */
+	typedef struct Grid {
+		int left, top; // 网格覆盖区域左上角坐标
+		int cell_width, cell_height;
+		int cols, rows;
+		int item_width, item_height; // 放入网格的对象的宽高
+		size_t* cell_start; // 长度为 cols * rows + 1
+		size_t* items; // 长度为 capacity
+		int* item_x, * item_y; // 与 items 一一对应、打包存放的对象坐标，可直接交给 collision_batch()
+		int* item_cell; // 长度为 capacity，重建时的临时数组
+		int* col_of, * row_of; // 区域内相对坐标到行列号的查找表，用查表代替除法
+		uint64_t* row_mask; // 长度为 rows，第 r 行第 c 列的格子非空时 row_mask[r] 的第 c 位为 1
+		size_t* chunk_start; // 长度为 GRID_MAX_CHUNKS * cols * rows，并行重建时每块对象在每个格子中的数量，随后改为写入位置
+		uint64_t* chunk_row_mask; // 长度为 GRID_MAX_CHUNKS * rows，并行重建时每块对象的 row_mask
+		size_t capacity;
+	} Grid;
+
+	/**
+	 * @brief 初始化网格。区域外的对象会被归入最近的边缘格子，因此仍能被正确查询到。
+	 *        空间从 arena 中划分，随 arena 一起重置与释放；arena 为 NULL 时用 malloc() 分配，须调用 grid_free() 释放。
+	 * @param capacity 一次最多放入网格的对象数量。
+	 */
+	void grid_init(Grid* grid, const int left, const int top, const int width, const int height,
+		const int cell_width, const int cell_height, const int item_width, const int item_height, const size_t capacity, Arena* arena);
+
+	/**
+	 * @brief 用左上角坐标为 (xs[i], ys[i]) 的 count 个对象重建网格，count 不得超过 capacity。
+	 *        对象足够多且任务调度器已启动时分块并行统计与放置，结果与串行重建逐位一致。
+	 */
+	void grid_build(Grid* grid, const int* xs, const int* ys, const size_t count);
+
+	/**
+	 * @brief 计算可能与给定矩形相交的对象所在的格子范围（闭区间）。
+	 */
+	void grid_query_range(const Grid* grid, const int x, const int y, const int width, const int height,
+		int* col_begin, int* col_end, int* row_begin, int* row_end);
+
+	/**
+	 * @brief 判断给定行列范围（闭区间）内是否所有格子都为空，用于在逐格检查之前快速跳过。
+	 */
+	bool grid_range_empty(const Grid* grid, const int col_begin, const int col_end, const int row_begin, const int row_end);
+
+	/**
+	 * @brief 释放用 malloc() 分配的网格。
+	 */
+	void grid_free(Grid* grid);
+
+#endif /* GRID_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
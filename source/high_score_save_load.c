@@ -6,47 +6,228 @@
  * @version v1.0
  */
 
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200112L
+#endif
 #include "high_score_save_load.h"
+#include <ctype.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include "log.h"
 
- /**
-  * @brief 保存各难度最高分。
-  */
-void high_score_save(const int high_score[DIFFICULTY_COUNT]) {
-	FILE* high_score_file = NULL;
-	if (fopen_s(&high_score_file, HIGH_SCORE_FILE, "wb")) {
-		fprintf(stderr, "Failed to open high score file when saving.\n");
-		exit(EXIT_FAILURE);
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define HIGH_SCORE_FILE_SIZE_FOR(count) (4 + 1 + 1 + 4 * (count) + 4)
+#define HIGH_SCORE_FILE_SIZE HIGH_SCORE_FILE_SIZE_FOR(DIFFICULTY_COUNT)
+#define HIGH_SCORE_MAX_FILE_SIZE HIGH_SCORE_FILE_SIZE_FOR(255) // 难度数占 1 字节
+#define HIGH_SCORE_PATH_SIZE 512
+
+static const unsigned char high_score_magic[4] = { 'G', 'H', 'S', 'C' };
+
+static FILE* high_score_open(const char* path, const char* mode) {
+#if defined(_MSC_VER)
+	FILE* file = NULL;
+	if (fopen_s(&file, path, mode)) {
+		return NULL;
+	}
+	return file;
+#else
+	return fopen(path, mode);
+#endif
+}
+
+/**
+ * @brief 把已写入的内容刷到磁盘上，确保替换原文件之前临时文件的内容已经落盘，否则崩溃或断电后替换过的文件可能是空的。
+ *        Windows 上由 high_score_replace() 的 MOVEFILE_WRITE_THROUGH 保证。
+ */
+static bool high_score_sync(FILE* file) {
+	if (fflush(file) != 0) {
+		return false;
+	}
+#ifdef _WIN32
+	return true;
+#else
+	return fsync(fileno(file)) == 0;
+#endif
+}
+
+/**
+ * @brief 用临时文件替换目标文件。Windows 上 rename() 不能覆盖已存在的文件，因此改用 MoveFileEx()。
+ */
+static bool high_score_replace(const char* from, const char* to) {
+#ifdef _WIN32
+	return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	return rename(from, to) == 0;
+#endif
+}
+
+static uint32_t high_score_checksum(const unsigned char* data, const size_t size) {
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static void put_uint32(unsigned char* data, const uint32_t value) {
+	for (int i = 0; i < 4; ++i) {
+		data[i] = (unsigned char)(value >> (8 * i));
+	}
+}
+
+static uint32_t get_uint32(const unsigned char* data) {
+	uint32_t value = 0;
+	for (int i = 0; i < 4; ++i) {
+		value |= (uint32_t)data[i] << (8 * i);
 	}
+	return value;
+}
 
+/**
+ * @brief 保存各难度最高分。
+ */
+bool high_score_save(const int high_score[DIFFICULTY_COUNT], const char* path) {
+	unsigned char data[HIGH_SCORE_FILE_SIZE];
+	memcpy(data, high_score_magic, sizeof(high_score_magic));
+	data[4] = HIGH_SCORE_VERSION;
+	data[5] = DIFFICULTY_COUNT;
 	for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
-		fprintf(high_score_file, "%d\n", high_score[i]);
-		fprintf(stdout, "Saved: Difficulty %d has a high score of %d\n", i, high_score[i]);
+		put_uint32(data + 6 + 4 * i, (uint32_t)high_score[i]);
 	}
+	put_uint32(data + HIGH_SCORE_FILE_SIZE - 4, high_score_checksum(data, HIGH_SCORE_FILE_SIZE - 4));
 
+	char temp_path[HIGH_SCORE_PATH_SIZE];
+	snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+	FILE* high_score_file = high_score_open(temp_path, "wb");
+	if (!high_score_file) {
+		LOG_WARN("Failed to open high score file %s when saving.", temp_path);
+		return false;
+	}
+
+	const bool written = fwrite(data, 1, sizeof(data), high_score_file) == sizeof(data) && high_score_sync(high_score_file);
 	fclose(high_score_file);
+
+	if (!written || !high_score_replace(temp_path, path)) {
+		LOG_WARN("Failed to write high score file %s.", path);
+		remove(temp_path);
+		return false;
+	}
+
+	for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
+		LOG_INFO("Saved: Difficulty %d has a high score of %d", i, high_score[i]);
+	}
+	return true;
 }
 
 /**
- * @brief 读取各难度最高分。
+ * @brief 读取 v1.0 的纯文本格式：每行一个十进制数。
+ *        内容必须只由空白与至少一个（可带负号的）十进制数组成，否则视为损坏的文件而不是旧格式，以免文件头损坏时被当作全 0 的旧记录迁移、覆盖。
  */
-void high_score_load(int high_score[DIFFICULTY_COUNT]) {
-	FILE* high_score_file = NULL;
-	if (fopen_s(&high_score_file, HIGH_SCORE_FILE, "rb")) {
-		fprintf(stderr, "Failed to open high score file when saving.\n");
-		exit(EXIT_FAILURE);
+static bool high_score_parse_legacy(const unsigned char* data, const size_t size, int high_score[DIFFICULTY_COUNT]) {
+	char text[HIGH_SCORE_FILE_SIZE * 8];
+	if (size >= sizeof(text)) {
+		return false;
 	}
+	memcpy(text, data, size);
+	text[size] = '\0';
 
-	for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
-		if (fscanf_s(high_score_file, "%d\n", high_score + i) != EOF) {
-			fprintf(stdout, "Loaded: Difficulty %d has a high score of %d\n", i, high_score[i]);
+	size_t numbers = 0;
+	for (size_t i = 0; i < size; ) {
+		if (isspace(data[i])) {
+			++i;
+			continue;
+		}
+		if (data[i] == '-') {
+			++i;
+		}
+		if (i == size || !isdigit(data[i])) {
+			return false;
 		}
-		else {
+		while (i < size && isdigit(data[i])) {
+			++i;
+		}
+		if (i < size && !isspace(data[i])) {
+			return false;
+		}
+		++numbers;
+	}
+	if (numbers == 0) {
+		return false;
+	}
+
+	const char* cursor = text;
+	for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
+		char* end;
+		const long value = strtol(cursor, &end, 10);
+		if (end == cursor) {
 			high_score[i] = 0;
-			fprintf(stderr, "EOF when loading high score.\n");
+			LOG_WARN("EOF when loading high score.");
+			continue;
 		}
+		high_score[i] = (int)value;
+		cursor = end;
+	}
+	return true;
+}
+
+/**
+ * @brief 读取各难度最高分。
+ */
+bool high_score_load(int high_score[DIFFICULTY_COUNT], const char* path, bool* legacy) {
+	for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
+		high_score[i] = 0;
+	}
+	if (legacy) {
+		*legacy = false;
+	}
+
+	FILE* high_score_file = high_score_open(path, "rb");
+	if (!high_score_file) {
+		LOG_INFO("No high score file %s, starting from zero.", path);
+		return false;
 	}
 
+	unsigned char data[HIGH_SCORE_MAX_FILE_SIZE];
+	const size_t size = fread(data, 1, sizeof(data), high_score_file);
 	fclose(high_score_file);
+
+	bool ok;
+	if (size >= sizeof(high_score_magic) && !memcmp(data, high_score_magic, sizeof(high_score_magic))) {
+		// 难度数可能与本程序不同（difficulty.cfg 增删了难度），共有的难度保留最高分，新增的难度从 0 开始。
+		const size_t count = size > 5 ? data[5] : 0;
+		const size_t file_size = HIGH_SCORE_FILE_SIZE_FOR(count);
+		ok = size == file_size && data[4] == HIGH_SCORE_VERSION &&
+			get_uint32(data + file_size - 4) == high_score_checksum(data, file_size - 4);
+		for (int i = 0; ok && i < DIFFICULTY_COUNT && (size_t)i < count; ++i) {
+			high_score[i] = (int)get_uint32(data + 6 + 4 * i);
+		}
+	}
+	else {
+		ok = high_score_parse_legacy(data, size, high_score);
+		if (ok && legacy) {
+			*legacy = true;
+		}
+	}
+
+	if (!ok) {
+		for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
+			high_score[i] = 0;
+		}
+		LOG_WARN("Corrupted high score file %s, starting from zero.", path);
+		return false;
+	}
+
+	for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
+		LOG_INFO("Loaded: Difficulty %d has a high score of %d", i, high_score[i]);
+	}
+	return true;
 }
@@ -1,11 +1,14 @@
 /**
- * @file high_score_save_load.c
- * @brief 这份源文件实现了最高分保存、读取的函数。
+ * @file high_score_save_load.h
+ * @brief 这份头文件声明了最高分保存、读取的函数。
  * @author 刘博闻
  * @date 2025-12-10
  * @version v1.0
  */
 
+#include <stdbool.h>
+#include "difficulty_table.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -13,11 +16,23 @@ extern "C" {
 #ifndef HIGH_SCORE_SAVE_LOAD_H
 #define HIGH_SCORE_SAVE_LOAD_H
 
-#define DIFFICULTY_COUNT 3
 #define HIGH_SCORE_FILE "high_score.dat"
+#define HIGH_SCORE_VERSION 2 // v1.0 每行一个十进制数的纯文本格式视为版本 1
+
+	/**
+	 * @brief 保存各难度最高分。文件格式（整数均为小端序）：
+	 *        "GHSC"、版本号（1 字节）、难度数（1 字节）、各难度最高分（各 4 字节）、之前所有字节的 FNV-1a 校验和（4 字节）。
+	 *        先写入临时文件，成功后再替换原文件，写到一半崩溃或断电也不会损坏原有的记录。
+	 * @return 是否保存成功。
+	 */
+	bool high_score_save(const int high_score[DIFFICULTY_COUNT], const char* path);
 
-	void high_score_save(const int high_score[DIFFICULTY_COUNT]);
-	void high_score_load(int high_score[DIFFICULTY_COUNT]);
+	/**
+	 * @brief 读取各难度最高分。也能读取 v1.0 的纯文本格式，此时 legacy 被置为 true，调用者应当以新格式重新保存。
+	 *        文件中的难度数与 DIFFICULTY_COUNT 不同时，只读取共有的难度。
+	 * @return 文件不存在、格式错误或校验和不符时返回 false，此时各难度最高分均为 0。
+	 */
+	bool high_score_load(int high_score[DIFFICULTY_COUNT], const char* path, bool* legacy);
 
 #endif /* HIGH_SCORE_SAVE_LOAD_H */
 
@@ -0,0 +1,100 @@
+/**
+ * @file high_score_service.cpp
+ * @brief 这份源文件实现了最高分服务。内存中的最高分由互斥锁保护，后台线程在有新纪录时取一份快照，
+ *        在锁外调用 high_score_save() 写盘；连续多次刷新纪录只会合并为最后一次写盘。
+ * @author 刘博闻
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <stdio.h>
+#include "high_score_service.h"
+#include "log.h"
+
+static std::mutex g_high_score_mutex;
+static std::condition_variable g_high_score_changed;
+static std::thread g_high_score_thread;
+static int g_high_score[DIFFICULTY_COUNT] = { 0 };
+static bool g_high_score_dirty = false; // 内存中的最高分是否尚未写盘
+static bool g_high_score_running = false;
+static char g_high_score_path[512] = HIGH_SCORE_FILE;
+
+static void high_score_thread_main() {
+	std::unique_lock<std::mutex> lock(g_high_score_mutex);
+
+	while (true) {
+		g_high_score_changed.wait(lock, [] { return g_high_score_dirty || !g_high_score_running; });
+		if (!g_high_score_dirty) {
+			break; // 已停止，且没有尚未写盘的纪录。
+		}
+
+		int snapshot[DIFFICULTY_COUNT];
+		for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
+			snapshot[i] = g_high_score[i];
+		}
+		g_high_score_dirty = false;
+
+		lock.unlock();
+		high_score_save(snapshot, g_high_score_path);
+		lock.lock();
+	}
+}
+
+void high_score_service_start(const char* path) {
+	if (g_high_score_running) {
+		return;
+	}
+
+	snprintf(g_high_score_path, sizeof(g_high_score_path), "%s", path);
+
+	bool legacy = false;
+	high_score_load(g_high_score, g_high_score_path, &legacy);
+	if (legacy) {
+		LOG_INFO("Migrating high score file %s to version %d.", g_high_score_path, HIGH_SCORE_VERSION);
+	}
+
+	g_high_score_dirty = legacy;
+	g_high_score_running = true;
+	g_high_score_thread = std::thread(high_score_thread_main);
+}
+
+void high_score_service_stop() {
+	{
+		std::lock_guard<std::mutex> lock(g_high_score_mutex);
+		if (!g_high_score_running) {
+			return;
+		}
+		g_high_score_running = false;
+	}
+
+	g_high_score_changed.notify_one();
+	g_high_score_thread.join();
+}
+
+void high_score_get(int high_score[DIFFICULTY_COUNT]) {
+	std::lock_guard<std::mutex> lock(g_high_score_mutex);
+	for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
+		high_score[i] = g_high_score[i];
+	}
+}
+
+bool high_score_submit(const int difficulty, const int score) {
+	if (difficulty < 0 || difficulty >= DIFFICULTY_COUNT) {
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(g_high_score_mutex);
+		if (score <= g_high_score[difficulty]) {
+			return false;
+		}
+		g_high_score[difficulty] = score;
+		g_high_score_dirty = true;
+	}
+
+	g_high_score_changed.notify_one();
+	return true;
+}
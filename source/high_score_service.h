@@ -0,0 +1,45 @@
+/**
+ * @file high_score_service.h
+ * @brief 这份头文件声明了最高分服务。最高分只在启动时读取一次，之后保存在内存中；
+ *        刷新纪录时只更新内存并通知后台线程写盘，调用者（UI 线程）从不等待磁盘。
+ * @author 刘博闻
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include "high_score_save_load.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef HIGH_SCORE_SERVICE_H
+#define HIGH_SCORE_SERVICE_H
+
+	/**
+	 * @brief 读取最高分文件并启动后台写盘线程。文件不存在或损坏时从 0 开始；读到 v1.0 的纯文本格式时会以新格式重新保存。
+	 */
+	void high_score_service_start(const char* path);
+
+	/**
+	 * @brief 写完尚未保存的最高分，然后停止后台线程。
+	 */
+	void high_score_service_stop();
+
+	/**
+	 * @brief 取得内存中的各难度最高分，不访问磁盘。
+	 */
+	void high_score_get(int high_score[DIFFICULTY_COUNT]);
+
+	/**
+	 * @brief 提交一局的得分。超过该难度的最高分时更新内存，并通知后台线程写盘。
+	 * @return 是否刷新了纪录。
+	 */
+	bool high_score_submit(const int difficulty, const int score);
+
+#endif /* HIGH_SCORE_SERVICE_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
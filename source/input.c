@@ -0,0 +1,109 @@
+/**
+ * @file input.c
+ * @brief 这份源文件实现了缓冲输入层。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <string.h>
+#include "input.h"
+
+void input_init(InputQueue* queue) {
+	memset(queue, 0, sizeof(*queue));
+}
+
+/**
+ * @brief 把一个位的变化排入缓冲区。缓冲区已满时最早的事件提前生效，只丢失它的边沿标志，按下状态仍然正确。
+ */
+static void input_push(InputQueue* queue, const unsigned bit, const bool down) {
+	if (queue->count == INPUT_QUEUE_SIZE) {
+		const InputEvent* oldest = &queue->events[queue->head];
+		queue->held = oldest->down ? queue->held | oldest->bit : queue->held & ~(unsigned)oldest->bit;
+		queue->head = (queue->head + 1) & (INPUT_QUEUE_SIZE - 1);
+		--queue->count;
+		++queue->overflows;
+	}
+
+	InputEvent* event = &queue->events[(queue->head + queue->count) & (INPUT_QUEUE_SIZE - 1)];
+	event->bit = (uint16_t)bit;
+	event->down = down;
+	++queue->count;
+	queue->queued = down ? queue->queued | bit : queue->queued & ~bit;
+}
+
+void input_bind(InputQueue* queue, const unsigned key, const unsigned bits) {
+	if (key >= INPUT_KEY_COUNT) {
+		return;
+	}
+
+	// 先按旧的绑定松开，避免各个位的按键计数错乱。
+	const bool down = queue->key_down[key];
+	if (down) {
+		input_key(queue, key, false);
+	}
+	queue->bindings[key] = (uint16_t)(bits & INPUT_MASK);
+	if (down) {
+		input_key(queue, key, true);
+	}
+}
+
+void input_key(InputQueue* queue, const unsigned key, const bool down) {
+	if (key >= INPUT_KEY_COUNT || queue->key_down[key] == down) {
+		return;
+	}
+	queue->key_down[key] = down;
+
+	const unsigned bits = queue->bindings[key];
+	for (int i = 0; i < INPUT_BITS; ++i) {
+		if (!(bits >> i & 1)) {
+			continue;
+		}
+		if (down ? queue->bit_keys[i]++ == 0 : --queue->bit_keys[i] == 0) {
+			input_push(queue, 1u << i, down);
+		}
+	}
+}
+
+void input_release_all(InputQueue* queue) {
+	for (unsigned key = 0; key < INPUT_KEY_COUNT; ++key) {
+		input_key(queue, key, false);
+	}
+	input_inject(queue, 0);
+}
+
+void input_inject(InputQueue* queue, const unsigned held) {
+	const unsigned changed = (queue->queued ^ held) & INPUT_MASK;
+	for (int i = 0; i < INPUT_BITS; ++i) {
+		if (changed >> i & 1) {
+			input_push(queue, 1u << i, held >> i & 1);
+		}
+	}
+}
+
+void input_reset(InputQueue* queue) {
+	const size_t overflows = queue->overflows;
+	uint16_t bindings[INPUT_KEY_COUNT];
+	memcpy(bindings, queue->bindings, sizeof(bindings));
+
+	input_init(queue);
+	memcpy(queue->bindings, bindings, sizeof(bindings));
+	queue->overflows = overflows;
+}
+
+InputSnapshot input_tick(InputQueue* queue) {
+	const unsigned previous = queue->held;
+	unsigned changed = 0;
+	while (queue->count > 0) {
+		const InputEvent* event = &queue->events[queue->head];
+		// 这个位在本 tick 已经变化过一次，之后的事件留给下一个 tick。
+		if (changed & event->bit) {
+			break;
+		}
+		changed |= event->bit;
+		queue->held = event->down ? queue->held | event->bit : queue->held & ~(unsigned)event->bit;
+		queue->head = (queue->head + 1) & (INPUT_QUEUE_SIZE - 1);
+		--queue->count;
+	}
+	return input_snapshot(previous, queue->held);
+}
@@ -0,0 +1,109 @@
+/**
+ * @file input.h
+ * @brief 这份头文件声明了与平台无关的缓冲输入层。平台层把按键消息逐条交给 input_key()，事件按到达顺序存入环形缓冲区；
+ *        模拟核心每个 tick 调用一次 input_tick()，取得这个 tick 的输入快照：哪些位处于按下状态，以及哪些位刚刚按下、刚刚松开。
+ *        同一个位在一个 tick 内最多变化一次，更晚的事件留到之后的 tick，因此短于一个 tick 的点按也不会丢失。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#define INPUT_KEY_COUNT 256 // 按键编号的范围，Windows 的虚拟键码不超过 255
+#define INPUT_BITS 10 // 快照中每一组标志的位数
+#define INPUT_MASK ((1u << INPUT_BITS) - 1)
+#define INPUT_QUEUE_SIZE 256 // 环形缓冲区能容纳的事件数，须为 2 的幂
+
+	/**
+	 * @brief 一个 tick 的输入快照：低 INPUT_BITS 位是按下状态，其上依次是刚按下与刚松开的标志。
+	 *        按下状态的各个位与 world.h 中的 InputBit 一致，可以直接传给 world_step()。
+	 */
+	typedef uint32_t InputSnapshot;
+
+	/**
+	 * @brief 一个位的状态变化。
+	 */
+	typedef struct InputEvent {
+		uint16_t bit;
+		uint8_t down;
+	} InputEvent;
+
+	typedef struct InputQueue {
+		uint16_t bindings[INPUT_KEY_COUNT]; // 每个按键对应的位，一个位可以绑定多个按键
+		bool key_down[INPUT_KEY_COUNT];
+		uint8_t bit_keys[INPUT_BITS]; // 每个位当前被几个按键按住
+		unsigned queued; // 缓冲区中的事件全部生效后的按下状态
+		unsigned held; // 最近一次快照的按下状态
+		InputEvent events[INPUT_QUEUE_SIZE];
+		size_t head, count;
+		size_t overflows; // 统计：缓冲区放满时提前生效的事件数
+	} InputQueue;
+
+	void input_init(InputQueue* queue);
+
+	/**
+	 * @brief 把一个按键绑定到一个或多个位上，bits 为 0 时解除绑定。
+	 */
+	void input_bind(InputQueue* queue, const unsigned key, const unsigned bits);
+
+	/**
+	 * @brief 记录一次按键的按下或松开。按住不放时系统重复发送的按下消息会被忽略；
+	 *        绑定到同一个位的几个按键中，第一个按下与最后一个松开时才产生事件。
+	 */
+	void input_key(InputQueue* queue, const unsigned key, const bool down);
+
+	/**
+	 * @brief 松开所有按键，用于窗口失去焦点等收不到松开消息的场合。
+	 */
+	void input_release_all(InputQueue* queue);
+
+	/**
+	 * @brief 直接把按下状态改为 held，位的变化作为事件排入缓冲区。用于机器人、脚本与录像等不经过按键的输入来源。
+	 */
+	void input_inject(InputQueue* queue, const unsigned held);
+
+	/**
+	 * @brief 清空缓冲区与所有状态。
+	 */
+	void input_reset(InputQueue* queue);
+
+	/**
+	 * @brief 取得下一个 tick 的快照，每个 tick 恰好调用一次。
+	 */
+	InputSnapshot input_tick(InputQueue* queue);
+
+	/**
+	 * @brief 由前后两个 tick 的按下状态构造快照，用于回放只记录了按下状态的录像。
+	 */
+	static inline InputSnapshot input_snapshot(const unsigned previous, const unsigned held) {
+		const unsigned changed = (previous ^ held) & INPUT_MASK;
+		return (held & INPUT_MASK) | (changed & held) << INPUT_BITS | (changed & previous) << (2 * INPUT_BITS);
+	}
+
+	static inline unsigned input_held(const InputSnapshot snapshot) {
+		return snapshot & INPUT_MASK;
+	}
+
+	static inline unsigned input_pressed(const InputSnapshot snapshot) {
+		return snapshot >> INPUT_BITS & INPUT_MASK;
+	}
+
+	static inline unsigned input_released(const InputSnapshot snapshot) {
+		return snapshot >> (2 * INPUT_BITS) & INPUT_MASK;
+	}
+
+#endif /* INPUT_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
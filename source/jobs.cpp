@@ -0,0 +1,205 @@
+/**
+ * @file jobs.cpp
+ * @brief 这份源文件实现了工作窃取任务调度器。第 0 个队列属于工作线程以外的线程（如 UI 线程），第 1 至 workers 个队列各属于一个工作线程。
+ *        任务只在 jobs_parallel_for() 内部产生，生命周期不超过这次调用，因此完成计数放在调用者的栈上，
+ *        任务本身存放在定长的环形队列中，调度过程中没有任何内存分配。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "jobs.h"
+#include "log.h"
+
+#define JOBS_QUEUE_CAPACITY 256 // 每个队列可容纳的任务数，放不下的块由调用者直接执行
+#define JOBS_SPIN_COUNT 256 // 找不到任务时先让出时间片重试的次数，之后才休眠，以便接住下一个 tick 紧接着派发的任务
+
+/**
+ * @brief 一块待执行的任务。pending 指向所属 jobs_parallel_for() 调用的剩余块数。
+ */
+struct Job {
+	JobFunc func;
+	void* context;
+	size_t begin, end, chunk;
+	std::atomic<size_t>* pending;
+};
+
+/**
+ * @brief 一个线程的任务队列，[head, tail) 为队列中的任务，下标对 JOBS_QUEUE_CAPACITY 取模。
+ *        所有者从队尾存取，窃取者从队首取走。对齐到缓存行，避免相邻队列的锁互相干扰。
+ */
+struct alignas(64) JobQueue {
+	std::mutex mutex;
+	size_t head, tail;
+	Job jobs[JOBS_QUEUE_CAPACITY];
+};
+
+static JobQueue g_jobs_queues[JOBS_MAX_THREADS];
+static std::thread g_jobs_threads[JOBS_MAX_THREADS];
+static std::atomic<int> g_jobs_workers(0); // 工作线程数，不含调用线程
+static std::atomic<size_t> g_jobs_queued(0); // 所有队列中尚未被取走的任务数
+static std::atomic<bool> g_jobs_running(false);
+static std::mutex g_jobs_sleep_mutex;
+static std::condition_variable g_jobs_wake;
+static thread_local int t_jobs_queue = 0; // 当前线程所属的队列
+
+static bool jobs_pop(const int queue, Job* job) {
+	JobQueue& q = g_jobs_queues[queue];
+	std::lock_guard<std::mutex> lock(q.mutex);
+	if (q.head == q.tail) {
+		return false;
+	}
+	*job = q.jobs[--q.tail % JOBS_QUEUE_CAPACITY];
+	g_jobs_queued.fetch_sub(1, std::memory_order_relaxed);
+	return true;
+}
+
+/**
+ * @brief 从 thief 以外的队列的队首窃取一个任务，从 thief 的下一个队列开始依次尝试。
+ */
+static bool jobs_steal(const int thief, Job* job) {
+	const int queue_count = g_jobs_workers.load(std::memory_order_relaxed) + 1;
+	for (int k = 1; k < queue_count; ++k) {
+		JobQueue& q = g_jobs_queues[(thief + k) % queue_count];
+		std::lock_guard<std::mutex> lock(q.mutex);
+		if (q.head != q.tail) {
+			*job = q.jobs[q.head++ % JOBS_QUEUE_CAPACITY];
+			g_jobs_queued.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool jobs_take(const int queue, Job* job) {
+	return g_jobs_queued.load(std::memory_order_relaxed) > 0 && (jobs_pop(queue, job) || jobs_steal(queue, job));
+}
+
+static void jobs_run(const Job& job) {
+	job.func(job.context, job.begin, job.end, job.chunk);
+	job.pending->fetch_sub(1, std::memory_order_release);
+}
+
+static void jobs_worker_main(const int queue) {
+	t_jobs_queue = queue;
+
+	Job job;
+	while (true) {
+		for (int spin = 0; spin < JOBS_SPIN_COUNT; ++spin) {
+			if (jobs_take(queue, &job)) {
+				jobs_run(job);
+				spin = -1;
+				continue;
+			}
+			std::this_thread::yield();
+		}
+
+		std::unique_lock<std::mutex> lock(g_jobs_sleep_mutex);
+		g_jobs_wake.wait(lock, [] { return g_jobs_queued.load() > 0 || !g_jobs_running.load(); });
+		if (!g_jobs_running.load() && g_jobs_queued.load() == 0) {
+			break;
+		}
+	}
+}
+
+void jobs_start(const int thread_count) {
+	if (g_jobs_running.load()) {
+		return;
+	}
+
+	int threads = thread_count > 0 ? thread_count : (int)std::thread::hardware_concurrency();
+	threads = std::min(std::max(threads, 1), JOBS_MAX_THREADS);
+
+	g_jobs_running.store(true);
+	g_jobs_workers.store(threads - 1);
+	for (int i = 1; i < threads; ++i) {
+		g_jobs_threads[i] = std::thread(jobs_worker_main, i);
+	}
+
+	LOG_INFO("Job system started with %d threads.", threads);
+}
+
+void jobs_stop() {
+	if (!g_jobs_running.load()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(g_jobs_sleep_mutex);
+		g_jobs_running.store(false);
+	}
+	g_jobs_wake.notify_all();
+
+	const int workers = g_jobs_workers.load();
+	for (int i = 1; i <= workers; ++i) {
+		g_jobs_threads[i].join();
+	}
+	g_jobs_workers.store(0);
+}
+
+int jobs_thread_count() {
+	return g_jobs_workers.load(std::memory_order_relaxed) + 1;
+}
+
+size_t jobs_parallel_for(const size_t count, const size_t grain, JobFunc func, void* context) {
+	if (count == 0) {
+		return 0;
+	}
+
+	const size_t size = grain ? grain : 1;
+	const size_t chunks = (count + size - 1) / size;
+
+	if (chunks == 1 || g_jobs_workers.load(std::memory_order_relaxed) == 0) {
+		for (size_t c = 0; c < chunks; ++c) {
+			func(context, c * size, std::min(count, (c + 1) * size), c);
+		}
+		return chunks;
+	}
+
+	// 第 0 块与队列放不下的块留给调用线程自己执行，其余的放入自己的队列，等待空闲的线程窃取。
+	const int queue = t_jobs_queue;
+	size_t queued = 0;
+	std::atomic<size_t> pending(0);
+	{
+		JobQueue& q = g_jobs_queues[queue];
+		std::lock_guard<std::mutex> lock(q.mutex);
+		queued = std::min(chunks - 1, JOBS_QUEUE_CAPACITY - (q.tail - q.head));
+		pending.store(queued, std::memory_order_relaxed);
+		for (size_t c = chunks - 1; c > chunks - 1 - queued; --c) {
+			q.jobs[q.tail++ % JOBS_QUEUE_CAPACITY] = Job{ func, context, c * size, std::min(count, (c + 1) * size), c, &pending };
+		}
+		g_jobs_queued.fetch_add(queued, std::memory_order_relaxed);
+	}
+	{
+		// 持锁后再通知，避免工作线程在检查条件与开始等待之间错过通知。
+		std::lock_guard<std::mutex> lock(g_jobs_sleep_mutex);
+	}
+	g_jobs_wake.notify_all();
+
+	for (size_t c = 0; c < chunks - queued; ++c) {
+		func(context, c * size, std::min(count, (c + 1) * size), c);
+	}
+
+	// 等待期间继续执行任务：先取自己队列中的，再窃取别人的。这样在任务中嵌套调用也不会让线程空等。
+	Job job;
+	while (pending.load(std::memory_order_acquire) > 0) {
+		if (jobs_take(queue, &job)) {
+			jobs_run(job);
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+
+	return chunks;
+}
+
+size_t jobs_grain(const size_t count, const size_t min_grain, const size_t max_chunks) {
+	const size_t grain = max_chunks ? (count + max_chunks - 1) / max_chunks : count;
+	return std::max(std::max(grain, min_grain), (size_t)1);
+}
@@ -0,0 +1,60 @@
+/**
+ * @file jobs.h
+ * @brief 这份头文件声明了工作窃取（work-stealing）任务调度器。每个工作线程拥有一个双端队列，自己从队尾取任务，
+ *        空闲时从其他线程的队首窃取任务。jobs_parallel_for() 把一段下标区间切成固定大小的块分发出去，
+ *        调用者在等待期间也会执行任务，因此可以在任务中嵌套调用。
+ *        块的划分只取决于 count 与 grain，与线程数无关，调用者按块号合并结果即可得到与串行执行逐位一致的结果。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef JOBS_H
+#define JOBS_H
+
+#define JOBS_MAX_THREADS 64 // 线程数上限（含调用线程）
+
+	/**
+	 * @brief 处理下标 [begin, end) 的任务函数，chunk 为这一块的块号（从 0 开始）。
+	 */
+	typedef void (*JobFunc)(void* context, const size_t begin, const size_t end, const size_t chunk);
+
+	/**
+	 * @brief 启动调度器。
+	 * @param thread_count 参与计算的线程总数（含调用线程），不为正时取 CPU 的逻辑核心数。为 1 时不创建工作线程。
+	 */
+	void jobs_start(const int thread_count);
+
+	/**
+	 * @brief 等待工作线程退出。之后的 jobs_parallel_for() 在调用线程上串行执行。
+	 */
+	void jobs_stop();
+
+	/**
+	 * @brief 参与计算的线程总数（含调用线程）。调度器未启动时为 1。
+	 */
+	int jobs_thread_count();
+
+	/**
+	 * @brief 把 [0, count) 按每块 grain 个切成 (count + grain - 1) / grain 块并行执行，全部完成后返回。
+	 *        只有一块或调度器未启动时直接在调用线程上执行，没有任何额外开销。
+	 * @return 块数。
+	 */
+	size_t jobs_parallel_for(const size_t count, const size_t grain, JobFunc func, void* context);
+
+	/**
+	 * @brief 计算块大小：至少 min_grain 个，且块数不超过 max_chunks，便于调用者用定长数组保存每块的结果。
+	 */
+	size_t jobs_grain(const size_t count, const size_t min_grain, const size_t max_chunks);
+
+#endif /* JOBS_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,151 @@
+/**
+ * @file log.cpp
+ * @brief 这份源文件实现了异步日志。环形缓冲区的每个槽位带有一个序号，写入者用 CAS 抢占槽位、写完后发布序号，
+ *        因此多个线程可以同时写入而无需加锁；后台线程按顺序取出并输出。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <atomic>
+#include <thread>
+#include <stdarg.h>
+#include <stdio.h>
+#include "log.h"
+#include "timer.h"
+
+/**
+ * @brief 环形缓冲区的槽位。sequence 等于写入位置时槽位空闲，等于写入位置 + 1 时槽位中有待输出的日志。
+ */
+typedef struct LogSlot {
+	std::atomic<size_t> sequence;
+	LogRecord record;
+} LogSlot;
+
+static LogSlot g_log_slots[LOG_CAPACITY];
+static std::atomic<size_t> g_log_write_position(0);
+static size_t g_log_read_position = 0; // 只由后台线程访问
+static std::atomic<unsigned long long> g_log_dropped(0);
+static std::atomic<bool> g_log_running(false);
+
+static FILE* g_log_sink = NULL;
+static LogFormat g_log_format = LOG_FORMAT_TEXT;
+static std::thread g_log_thread;
+
+static const char* log_level_to_text(const int level) {
+	switch (level) {
+	case LOG_LEVEL_DEBUG: return "DEBUG";
+	case LOG_LEVEL_INFO:  return "INFO";
+	case LOG_LEVEL_WARN:  return "WARN";
+	case LOG_LEVEL_ERROR: return "ERROR";
+	default:              return "?";
+	}
+}
+
+/**
+ * @brief 取出并输出缓冲区中当前所有已发布的日志。
+ * @return 输出的日志条数。
+ */
+static size_t log_drain() {
+	size_t drained = 0;
+
+	while (true) {
+		LogSlot* slot = &g_log_slots[g_log_read_position & (LOG_CAPACITY - 1)];
+		if (slot->sequence.load(std::memory_order_acquire) != g_log_read_position + 1) {
+			break; // 下一条日志尚未写完。
+		}
+
+		if (g_log_format == LOG_FORMAT_BINARY) {
+			fwrite(&slot->record, sizeof(LogRecord), 1, g_log_sink);
+		}
+		else {
+			fprintf(g_log_sink, "[%10.4f] %-5s %s\n", slot->record.time, log_level_to_text(slot->record.level), slot->record.message);
+		}
+
+		// 槽位交还给写入者，供下一圈使用。
+		slot->sequence.store(g_log_read_position + LOG_CAPACITY, std::memory_order_release);
+		++g_log_read_position;
+		++drained;
+	}
+
+	return drained;
+}
+
+static void log_thread_main() {
+	while (g_log_running.load(std::memory_order_acquire)) {
+		if (log_drain() == 0) {
+			fflush(g_log_sink);
+			timer_sleep(0.002);
+		}
+	}
+
+	log_drain();
+	fflush(g_log_sink);
+}
+
+void log_start(FILE* sink, const LogFormat format) {
+	if (g_log_running.load()) {
+		return;
+	}
+
+	for (size_t i = 0; i < LOG_CAPACITY; ++i) {
+		g_log_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	g_log_write_position.store(0, std::memory_order_relaxed);
+	g_log_read_position = 0;
+
+	g_log_sink = sink;
+	g_log_format = format;
+	g_log_running.store(true, std::memory_order_release);
+	g_log_thread = std::thread(log_thread_main);
+}
+
+void log_stop() {
+	if (!g_log_running.exchange(false)) {
+		return;
+	}
+
+	g_log_thread.join();
+}
+
+void log_write(const int level, const char* format, ...) {
+	if (!g_log_running.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	// 抢占一个空闲槽位；若位置已被其他线程抢先占用，则重新读取位置后重试。
+	size_t position = g_log_write_position.load(std::memory_order_relaxed);
+	LogSlot* slot;
+	while (true) {
+		slot = &g_log_slots[position & (LOG_CAPACITY - 1)];
+		const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+
+		if (sequence == position) {
+			if (g_log_write_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (sequence < position) {
+			// 后台线程尚未取走上一圈的日志，缓冲区已满。
+			g_log_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else {
+			position = g_log_write_position.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->record.time = timer_now();
+	slot->record.level = level;
+
+	va_list args;
+	va_start(args, format);
+	vsnprintf(slot->record.message, LOG_MESSAGE_SIZE, format, args);
+	va_end(args);
+
+	slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+unsigned long long log_dropped_count() {
+	return g_log_dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,99 @@
+/**
+ * @file log.h
+ * @brief 这份头文件声明了异步日志。游戏逻辑只把日志写入无锁环形缓冲区，由后台线程统一输出，因此帧循环中不再有控制台 I/O。
+ *        低于 LOG_STRIP_LEVEL 的日志在编译期即被移除，不产生任何开销。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef LOG_H
+#define LOG_H
+
+	// 日志级别。使用宏而非枚举，以便在预处理阶段比较。
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+
+	// 编译期移除级别低于 LOG_STRIP_LEVEL 的日志，Release 版本默认移除 DEBUG 级日志。
+#ifndef LOG_STRIP_LEVEL
+#ifdef NDEBUG
+#define LOG_STRIP_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_STRIP_LEVEL LOG_LEVEL_DEBUG
+#endif
+#endif
+
+#define LOG_MESSAGE_SIZE 112 // 单条日志正文的最大长度，超出部分被截断
+#define LOG_CAPACITY 4096 // 环形缓冲区可容纳的日志条数，必须为 2 的幂
+
+	/**
+	 * @brief 日志的输出格式。
+	 */
+	typedef enum LogFormat {
+		LOG_FORMAT_TEXT, // 每条日志一行文本
+		LOG_FORMAT_BINARY // 直接写出定长的 LogRecord 结构体，适合事后用工具解析
+	} LogFormat;
+
+	/**
+	 * @brief 一条日志。
+	 */
+	typedef struct LogRecord {
+		double time; // 写入时单调时钟的读数，单位：秒
+		int level;
+		char message[LOG_MESSAGE_SIZE];
+	} LogRecord;
+
+	/**
+	 * @brief 启动后台输出线程。启动之前写入的日志会被直接丢弃。
+	 */
+	void log_start(FILE* sink, const LogFormat format);
+
+	/**
+	 * @brief 输出缓冲区中剩余的全部日志，然后停止后台线程。
+	 */
+	void log_stop();
+
+	/**
+	 * @brief 写入一条日志，可由任意线程调用，不会阻塞。缓冲区已满时丢弃该条日志。
+	 *        一般不直接调用，而是使用下方的 LOG_DEBUG 等宏。
+	 */
+	void log_write(const int level, const char* format, ...);
+
+	/**
+	 * @brief 因缓冲区已满而被丢弃的日志条数。
+	 */
+	unsigned long long log_dropped_count();
+
+#if LOG_STRIP_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) log_write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if LOG_STRIP_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) log_write(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_STRIP_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) log_write(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#define LOG_ERROR(...) log_write(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif /* LOG_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -7,113 +7,189 @@
  */
 
 #include <windows.h>
+#include <psapi.h>
+#include <graphics.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
-#include "list.h"
 #include "object.h"
 #include "render.h"
 #include "control.h"
-#include "high_score_save_load.h"
+#include "world.h"
+#include "timer.h"
+#include "log.h"
+#include "replay.h"
+#include "profiler.h"
+#include "high_score_service.h"
+#include "jobs.h"
+#include "snapshot.h"
+#include "render_thread.h"
+#include "input.h"
+#include "bot.h"
+
+#define TICK_SECONDS (1.0 / WORLD_TICK_RATE) // 每个 tick 代表的真实时间，单位：秒
+#define MAX_CATCH_UP_TICKS 5 // 每次渲染之前最多补算的 tick 数，超出的部分直接丢弃，避免越落后越追不上
+#define RENDER_UNCAPPED 0 // 为 1 时渲染线程不限帧率，否则每个 tick 绘制一帧
+#define RENDER_MODE RENDER_MODE_DIRTY_RECTS // 游戏画面的渲染方式，低配机器上可以减少填充像素数与 GDI 调用次数
+#define REPLAY_FILE "last_replay.rpl" // 最近一局游戏的录像
+#define PROFILER_TRACE_FILE "profile_trace.json" // F4 导出的 Chrome trace
+#define JOB_THREADS 0 // 模拟核心使用的线程数（含 UI 线程），为 0 时使用所有 CPU 核心
+#define SPRITE_ATLAS_FILE L"image\\galaxy.atlas" // 由 bench/atlas_pack.cpp 生成的精灵图集
+#define BOT_REPORT_TICKS (60 * WORLD_TICK_RATE) // 自动驾驶时每隔这么多个 tick 在日志中报告一次帧耗时与内存占用
 
-#define SCREEN_WIDTH 600
-#define SCREEN_HEIGHT 800
-#define FPS 60
-
-extern RenderTextures g_renderTextures;
+/**
+ * @brief 输入快照中模拟核心不使用的位，由界面处理。
+ */
+enum UiInputBit {
+	INPUT_PAUSE = 1 << 5,
+	INPUT_TOGGLE_OVERLAY = 1 << 6,
+	INPUT_TOGGLE_TRACE = 1 << 7,
+	INPUT_RELOAD_DIFFICULTY = 1 << 8
+};
 
-Object* player = NULL;
-List* enemy_list = NULL, * bullet_list = NULL;
+GameWorld world;
+Replay replay; // 当前这局游戏的录像
 
 int difficulty;
-const int starting_hp[DIFFICULTY_COUNT] = { 2, 2, 1 };
-const int delta_hp[DIFFICULTY_COUNT] = { 1, 1, 1 };
-const double min_fire_gap[DIFFICULTY_COUNT] = { 0.4, 0.5, 0.6 }; // 单位：秒
-const double min_enemy_spawn_gap[DIFFICULTY_COUNT] = { 0.3, 0.2, 0.1 }; // 单位：秒
-const int player_speed[DIFFICULTY_COUNT] = { 8, 12, 12 }; // 单位：像素每帧
-const int enemy_speed[DIFFICULTY_COUNT] = { 6, 9, 9 }; // 单位：像素每帧
-const int bullet_speed[DIFFICULTY_COUNT] = { 12, 18, 18 }; // 单位：像素每帧
 
-clock_t last_bullet_spawn_time, last_enemy_spawn_time;
+GameControlData game_control_data;
 
-#define POINTS_PER_HIT 10
+InputQueue input_queue; // 游戏画面中收到的按键事件，每个 tick 取出一个快照
 
-GameControlData game_control_data;
+size_t stress_entities; // 命令行给出 --stress N 时大于 0，以压力测试模式运行，目标是同时存活这么多个对象，见 world_stress_params()
+int stress_bullets_per_shot; // 压力测试中覆盖扇形弹幕的子弹数，为 0 时不覆盖
+int stress_spread = -1; // 压力测试中覆盖扇形两端子弹的横向速度，为负时不覆盖
+int stress_enemies_per_spawn; // 压力测试中覆盖每次生成的敌机数，为 0 时不覆盖
+
+bool bot_enabled; // 命令行给出 --bot 时由 bot_input() 代替键盘操作
+unsigned long long bot_tick_limit; // 自动驾驶运行的 tick 数上限，为 0 时不限
+double bot_second_limit; // 自动驾驶运行的真实时间上限，单位：秒，为 0 时不限
+unsigned long long bot_ticks; // 自动驾驶已经模拟的 tick 数，跨越所有对局
+double bot_begin_time;
+size_t session_count; // 本次运行开始过的对局数
+
+double tick_accumulator; // 尚未被模拟的真实时间，单位：秒
+double last_frame_time; // 上一次进入游戏循环时单调时钟的读数，单位：秒
 
 /**
- * @brief 处理玩家移动。
+ * @brief 绑定游戏中使用的按键：WASD 或方向键移动，空格射击，ESC 暂停，F3 ~ F5 为调试用的按键。
  */
-void player_move();
+void input_setup();
 
 /**
- * @brief 处理玩家开火。
+ * @brief 取出窗口消息队列中所有的按键消息交给输入层，不再逐键查询键盘状态。窗口失去焦点时松开所有按键。
  */
-void player_fire();
+void input_collect();
 
 /**
- * @brief 处理敌机生成。
+ * @brief 进入游戏画面时清空输入层，丢弃菜单期间积累的按键消息，并以当前的键盘状态作为起点。
  */
-void enemy_spawn();
+void input_sync();
 
 /**
- * @brief 处理敌机向下移动，并删除超出屏幕底端的敌机。
+ * @brief 处理调试用的按键：F3 显示或隐藏性能分析叠加层，F4 开始或停止导出 Chrome trace，
+ *        F5 重新读取 difficulty.cfg（仅 DIFFICULTY_HOT_RELOAD 为 1 时，下一局开始生效）。
+ * @param pressed 本 tick 刚按下的位。
  */
-void enemy_move();
+void debug_keys_handle(const unsigned pressed);
 
 /**
- * @brief 处理子弹向上移动，并删除超出屏幕顶端的子弹。
+ * @brief 压力测试模式下每秒在日志中报告一次同时存活的对象数、每 tick 的模拟耗时与渲染帧率。
  */
-void bullet_move();
+void stress_report(const double step_seconds);
 
 /**
- * @brief 对所有敌机，判断其是否被子弹击中。
+ * @brief 每局使用的参数：压力测试模式下为 world_stress_params() 加上命令行中的覆盖项，否则为当前难度的默认参数。
  */
-void enemy_bullet_collision();
+WorldParams session_params();
 
 /**
- * @brief 对所有敌机，判断其是否与玩家碰撞。
+ * @brief 解析命令行：--bot 由自动驾驶的玩家操作，跳过菜单，一局结束后立即开始下一局，得分不计入最高分；
+ *        --ticks N 与 --minutes N 限定自动驾驶运行的 tick 数或时间，到达后退出；--difficulty D 选择难度；
+ *        --stress N 以压力测试模式运行，--bullets-per-shot N、--spread N 与 --enemies-per-spawn N 覆盖其中的对应参数，
+ *        含义与 bench/headless.cpp 相同。
+ * @return 参数有误时输出用法并返回 false。
  */
-void enemy_player_collision();
+bool parse_arguments(const int argc, char* argv[]);
 
 /**
- * @brief 初始化游戏对象。
+ * @brief 自动驾驶时每 BOT_REPORT_TICKS 个 tick 在日志中报告一次对局数、帧耗时、帧率与进程的内存占用，供长时间稳定性测试分析。
+ * @return 是否已经到达 --ticks 或 --minutes 给出的上限。
  */
-void object_init();
+bool bot_report();
 
 /**
- * @brief 对当前帧，处理所有游戏对象的移动、添加、删除等操作。
+ * @brief 开始一局新游戏：用新的随机数种子初始化模拟状态，并开始录制录像。
  */
-void object_update();
+void session_start();
 
 /**
- * @brief 释放游戏对象的内存。
+ * @brief 结束当前这局游戏：保存录像。模拟状态保留到下一局开始时整体重置。
  */
-void object_free();
+void session_end();
 
-int main() {
+int main(int argc, char* argv[]) {
 
-	window_create(SCREEN_WIDTH, SCREEN_HEIGHT, L"飞机大战");
+	if (!parse_arguments(argc, argv)) {
+		return EXIT_FAILURE;
+	}
 
-	render_load_texture(
-		L"image\\background.png",
-		L"image\\player.png",
-		L"image\\enemy.png",
-		L"image\\bullet.png"
-	);
+	log_start(stdout, LOG_FORMAT_TEXT);
+	high_score_service_start(HIGH_SCORE_FILE);
+	jobs_start(JOB_THREADS);
+	input_setup();
+
+	// 菜单界面只有 EasyX 实现，因此窗口程序固定使用 EasyX 后端；无窗口的运行方式见 bench/headless.cpp。
+	const RenderBackend* backend = &render_backend_easyx;
+	backend->open(SCREEN_WIDTH, SCREEN_HEIGHT, L"飞机大战");
+	render_set_mode(RENDER_MODE);
+	backend->load_textures(SPRITE_ATLAS_FILE);
+
+	if (stress_entities > 0) {
+		const WorldParams stress_params = session_params();
+		snapshot_init(stress_params.capacity);
+		profiler_set_overlay(true);
+		LOG_INFO("Stress mode: %d bullets per shot, %d enemies per tick.", stress_params.bullets_per_shot, stress_params.enemies_per_spawn);
+	}
+	else {
+		// 各难度的默认容量相同，菜单中改变难度不影响快照的容量。
+		snapshot_init(world_default_params(difficulty).capacity);
+	}
+	render_thread_start(backend, TICK_SECONDS, RENDER_UNCAPPED);
 
 	game_control_data.running = true;
 	game_control_to_menu(&game_control_data);
+	if (bot_enabled) {
+		profiler_set_overlay(true);
+		bot_begin_time = timer_now();
+		LOG_INFO("Bot mode: difficulty %d, %llu ticks, %.0f seconds (0 = unlimited).", difficulty, bot_tick_limit, bot_second_limit);
+		session_start();
+	}
+	GameState last_state = game_control_data.state;
 	while (game_control_data.running) {
 
+		// 刚从其他状态进入游戏时重置计时，菜单与暂停期间经过的时间不计入模拟。
+		if (game_control_data.state == PLAYING && last_state != PLAYING) {
+			last_frame_time = timer_now();
+			tick_accumulator = 0;
+			input_sync();
+			render_thread_resume();
+		}
+		// 离开游戏画面时暂停渲染线程，之后由本线程绘制菜单。
+		else if (game_control_data.state != PLAYING && last_state == PLAYING) {
+			render_thread_pause();
+		}
+		last_state = game_control_data.state;
+
 		if (game_control_data.state == MENU) {
 
 			int high_score[DIFFICULTY_COUNT] = { 0 };
-			high_score_load(high_score);
-			const int choice = render_draw_main_menu(SCREEN_WIDTH, SCREEN_HEIGHT, high_score, difficulty, FPS);
+			high_score_get(high_score);
+			const int choice = render_draw_main_menu(SCREEN_WIDTH, SCREEN_HEIGHT, high_score, difficulty);
 
 			if (choice == 0) {
-				object_init();
-				game_control_start(&game_control_data, starting_hp[difficulty]);
+				session_start();
 			}
 			else if (choice == 1) {
 				game_control_to_settings(&game_control_data);
@@ -124,85 +200,118 @@ int main() {
 		}
 		else if (game_control_data.state == SETTINGS) {
 
-			difficulty = render_draw_difficulty_menu(SCREEN_WIDTH, SCREEN_HEIGHT, difficulty, FPS);
+			difficulty = render_draw_difficulty_menu(SCREEN_WIDTH, SCREEN_HEIGHT, difficulty);
 
-			fprintf(stdout, "Difficulty set to %d.\n", difficulty);
+			LOG_INFO("Difficulty set to %d.", difficulty);
 
 			game_control_to_menu(&game_control_data);
 		}
 		else if (game_control_data.state == PLAYING) {
 
-			object_update();
-			const GameplayVisualState state{
-				SCREEN_WIDTH,
-				SCREEN_HEIGHT,
-				game_control_data.score,
-				L"",
-				(const Object*)player,
-				(const List*)enemy_list,
-				(const List*)bullet_list,
-				difficulty,
-				game_control_data.hp,
-				starting_hp[difficulty]
-			};
-			render_draw_current_frame(&state);
-
-			if (GetAsyncKeyState(VK_ESCAPE) & 0x8000) {
-				game_control_pause(&game_control_data);
+			PROFILE_BEGIN(PROFILE_FRAME);
+			PROFILE_BEGIN(PROFILE_INPUT);
+			input_collect();
+			PROFILE_END(PROFILE_INPUT);
+
+			const double now = timer_now();
+			tick_accumulator += now - last_frame_time;
+			last_frame_time = now;
+
+			// 以固定步长推进模拟，保证游戏速度与帧率、机器负载无关。
+			int ticks = 0;
+			while (tick_accumulator >= TICK_SECONDS && game_control_data.state == PLAYING) {
+				const InputSnapshot snapshot = input_tick(&input_queue);
+				debug_keys_handle(input_pressed(snapshot));
+				const unsigned input = bot_enabled ? bot_input(&world) : input_held(snapshot) & INPUT_GAME_MASK;
+				replay_record(&replay, input);
+				const double step_begin = timer_now();
+				world_step(&world, input);
+				snapshot_publish(&world);
+				if (stress_entities > 0) {
+					stress_report(timer_now() - step_begin);
+				}
+				tick_accumulator -= TICK_SECONDS;
+
+				if (bot_enabled && bot_report()) {
+					session_end();
+					game_control_data.running = false;
+					break;
+				}
+
+				// 暂停键与其他按键一样按 tick 取自快照，暂停之后不再推进模拟。
+				if (input_pressed(snapshot) & INPUT_PAUSE) {
+					game_control_pause(&game_control_data);
+				}
+
+				if (++ticks == MAX_CATCH_UP_TICKS) {
+					tick_accumulator = 0;
+					break;
+				}
 			}
+
+			// 游戏画面由渲染线程根据快照绘制，本线程只负责输入与模拟，不会被绘制拖慢。休眠到下一个 tick 到期为止。
+			PROFILE_BEGIN(PROFILE_SLEEP);
+			timer_sleep(TICK_SECONDS - tick_accumulator - (timer_now() - last_frame_time));
+			PROFILE_END(PROFILE_SLEEP);
+
+			PROFILE_END(PROFILE_FRAME);
+			profiler_frame_end();
 		}
 		else if (game_control_data.state == PAUSED) {
 
-			int high_score[DIFFICULTY_COUNT] = { 0 };
-			high_score_load(high_score);
-			high_score[difficulty] = game_control_data.score > high_score[difficulty] ? game_control_data.score : high_score[difficulty];
-			high_score_save(high_score);
+			// 压力测试与自动驾驶的得分不计入最高分。
+			if (stress_entities == 0 && !bot_enabled) {
+				high_score_submit(difficulty, game_control_data.score);
+			}
 
-			const int choice = render_draw_pause_menu(SCREEN_WIDTH, SCREEN_HEIGHT, FPS);
+			const int choice = render_draw_pause_menu(SCREEN_WIDTH, SCREEN_HEIGHT);
 
 			if (choice == 0) {
 				game_control_resume(&game_control_data);
 			}
 			else if (choice == 1) {
-				object_free();
-				object_init();
-				game_control_start(&game_control_data, starting_hp[difficulty]);
+				session_end();
+				session_start();
 			}
 			else if (choice == 2) {
-				object_free();
+				session_end();
 				game_control_to_menu(&game_control_data);
 			}
 			else if (choice == 3) {
-				object_free();
+				session_end();
 				game_control_data.running = false;
 			}
 		}
+		else if (game_control_data.state == GAMEOVER && bot_enabled) {
+
+			LOG_INFO("Bot session %zu ended at tick %llu with a score of %d.", session_count, world.tick, game_control_data.score);
+			session_end();
+			session_start();
+		}
 		else if (game_control_data.state == GAMEOVER) {
 
 			int high_score[DIFFICULTY_COUNT] = { 0 };
-			high_score_load(high_score);
-			high_score[difficulty] = game_control_data.score > high_score[difficulty] ? game_control_data.score : high_score[difficulty];
-			high_score_save(high_score);
+			high_score_submit(difficulty, game_control_data.score);
+			high_score_get(high_score);
 
-			object_free();
+			session_end();
 			const GameplayVisualState state{
 				SCREEN_WIDTH,
 				SCREEN_HEIGHT,
 				game_control_data.score,
 				L"",
-				(const Object*)player,
-				(const List*)enemy_list,
-				(const List*)bullet_list,
+				(const Object*)world.player,
+				world.pools,
 				difficulty,
 				game_control_data.hp,
-				starting_hp[difficulty]
+				world.starting_hp,
+				1.0
 			};
 
-			const int choice = render_draw_wasted_page(&state, high_score, FPS);
+			const int choice = render_draw_wasted_page(&state, high_score);
 
 			if (choice == 0) {
-				object_init();
-				game_control_start(&game_control_data, starting_hp[difficulty]);
+				session_start();
 			}
 			else if (choice == 1) {
 				game_control_to_menu(&game_control_data);
@@ -211,263 +320,263 @@ int main() {
 				game_control_data.running = false;
 			}
 		}
-
-		Sleep(1000 / FPS);
 	}
 
-	window_close();
+	render_thread_stop();
+	backend->close();
+	snapshot_free();
+	world_free(&world);
 
-	fprintf(stdout, "Exited.\n");
+	high_score_service_stop();
+	profiler_trace_stop();
+	jobs_stop();
+
+	LOG_INFO("Exited.");
+	log_stop();
 
 	return 0;
 }
 
 /**
- * @brief 处理玩家移动。
+ * @brief 绑定游戏中使用的按键：WASD 或方向键移动，空格射击，ESC 暂停，F3 ~ F5 为调试用的按键。
  */
-void player_move() {
-	if (GetAsyncKeyState('W') & 0x8000 || GetAsyncKeyState(VK_UP) & 0x8000) {
-		player->y -= player_speed[difficulty];
-	}
-	if (GetAsyncKeyState('S') & 0x8000 || GetAsyncKeyState(VK_DOWN) & 0x8000) {
-		player->y += player_speed[difficulty];
-	}
-	if (GetAsyncKeyState('A') & 0x8000 || GetAsyncKeyState(VK_LEFT) & 0x8000) {
-		player->x -= player_speed[difficulty];
-	}
-	if (GetAsyncKeyState('D') & 0x8000 || GetAsyncKeyState(VK_RIGHT) & 0x8000) {
-		player->x += player_speed[difficulty];
-	}
-
-	// 超出边界时拉回
-	if (player->y < 0) {
-		player->y = 0;
-	}
-	if (player->y + PLAYER_HEIGHT > SCREEN_HEIGHT) {
-		player->y = SCREEN_HEIGHT - PLAYER_HEIGHT;
-	}
-	if (player->x < 0) {
-		player->x = 0;
-	}
-	if (player->x + PLAYER_WIDTH > SCREEN_WIDTH) {
-		player->x = SCREEN_WIDTH - PLAYER_WIDTH;
+void input_setup() {
+	static const struct {
+		unsigned key;
+		unsigned bits;
+	} bindings[] = {
+		{ 'W', INPUT_UP }, { VK_UP, INPUT_UP },
+		{ 'S', INPUT_DOWN }, { VK_DOWN, INPUT_DOWN },
+		{ 'A', INPUT_LEFT }, { VK_LEFT, INPUT_LEFT },
+		{ 'D', INPUT_RIGHT }, { VK_RIGHT, INPUT_RIGHT },
+		{ VK_SPACE, INPUT_FIRE },
+		{ VK_ESCAPE, INPUT_PAUSE },
+		{ VK_F3, INPUT_TOGGLE_OVERLAY },
+		{ VK_F4, INPUT_TOGGLE_TRACE },
+		{ VK_F5, INPUT_RELOAD_DIFFICULTY }
+	};
+
+	input_init(&input_queue);
+	for (size_t i = 0; i < sizeof(bindings) / sizeof(bindings[0]); ++i) {
+		input_bind(&input_queue, bindings[i].key, bindings[i].bits);
 	}
 }
 
 /**
- * @brief 处理玩家开火。
+ * @brief 取出窗口消息队列中所有的按键消息交给输入层，不再逐键查询键盘状态。窗口失去焦点时松开所有按键。
  */
-void player_fire() {
-	Object* new_bullet = (Object*)malloc(sizeof(Object));
-	if (!new_bullet) {
-		fprintf(stderr, "malloc() failed.\n");
-		exit(EXIT_FAILURE);
+void input_collect() {
+	ExMessage msg;
+	while (peekmessage(&msg, EM_KEY | EM_WINDOW)) {
+		if (msg.message == WM_KEYDOWN || msg.message == WM_KEYUP) {
+			input_key(&input_queue, msg.vkcode, msg.message == WM_KEYDOWN);
+		}
+		else if (msg.message == WM_ACTIVATE && LOWORD(msg.wParam) == WA_INACTIVE) {
+			input_release_all(&input_queue);
+		}
 	}
-
-	new_bullet->x = player->x + PLAYER_WIDTH / 2 - BULLET_WIDTH / 2;
-	new_bullet->y = player->y;
-	new_bullet->type = BULLET;
-
-	list_append(bullet_list, new_bullet);
 }
 
 /**
- * @brief 处理敌机生成。
+ * @brief 进入游戏画面时清空输入层，丢弃菜单期间积累的按键消息，并以当前的键盘状态作为起点。
+ *        这里逐键查询一次键盘状态，之后的按键变化都来自消息。
  */
-void enemy_spawn() {
-	Object* new_enemy = (Object*)malloc(sizeof(Object));
-	if (!new_enemy) {
-		fprintf(stderr, "malloc() failed.\n");
-		exit(EXIT_FAILURE);
+void input_sync() {
+	flushmessage(EM_KEY | EM_WINDOW);
+	input_reset(&input_queue);
+	for (unsigned key = 0; key < INPUT_KEY_COUNT; ++key) {
+		if (input_queue.bindings[key] && (GetAsyncKeyState((int)key) & 0x8000)) {
+			input_key(&input_queue, key, true);
+		}
 	}
-
-	new_enemy->x = rand() % (SCREEN_WIDTH - ENEMY_WIDTH);
-	new_enemy->y = -ENEMY_HEIGHT;
-	new_enemy->type = ENEMY;
-
-	list_append(enemy_list, new_enemy);
 }
 
 /**
- * @brief 处理敌机向下移动，并删除超出屏幕底端的敌机。
+ * @brief 处理调试用的按键：F3 显示或隐藏性能分析叠加层，F4 开始或停止导出 Chrome trace，
+ *        F5 重新读取 difficulty.cfg（仅 DIFFICULTY_HOT_RELOAD 为 1 时，下一局开始生效）。
+ * @param pressed 本 tick 刚按下的位。
  */
-void enemy_move() {
-	for (Node* enemy_node = enemy_list->head->next; enemy_node; ) {
-		/**
-		 * 此处不能在 for 循环语句中写入 enemy_node = enemy_node->next，
-		 * 因为在进入下一次循环之前，当前的 enemy_node 指针所指向的结点可能已经被释放，
-		 * 若再次访问 enemy_node->next 会引发段错误。
-		 * 应该额外用一个指针变量 next_enemy_node 提前记录后继节点的地址。
-		 */
-		Node* next_enemy_node = enemy_node->next;
-		Object* enemy = (Object*)enemy_node->data;
-
-		enemy->y += enemy_speed[difficulty];
-		if (enemy->y > SCREEN_HEIGHT) {
-			list_random_erase(enemy_list, enemy_node);
-
-			fprintf(stdout, "An enemy has been erased. (out of bound)\n");
+void debug_keys_handle(const unsigned pressed) {
+	if (pressed & INPUT_TOGGLE_OVERLAY) {
+		profiler_set_overlay(!profiler_overlay_visible());
+	}
+
+	if (pressed & INPUT_TOGGLE_TRACE) {
+		if (profiler_trace_active()) {
+			profiler_trace_stop();
 		}
+		else {
+			profiler_trace_start(PROFILER_TRACE_FILE);
+		}
+	}
 
-		enemy_node = next_enemy_node;
+#if DIFFICULTY_HOT_RELOAD
+	if (pressed & INPUT_RELOAD_DIFFICULTY) {
+		difficulty_reload(DIFFICULTY_FILE);
 	}
+#endif /* DIFFICULTY_HOT_RELOAD */
 }
 
 /**
- * @brief 处理子弹向上移动，并删除超出屏幕顶端的子弹。
+ * @brief 压力测试模式下每秒在日志中报告一次同时存活的对象数、每 tick 的模拟耗时与渲染帧率。
  */
-void bullet_move() {
-	for (Node* bullet_node = bullet_list->head->next; bullet_node; ) {
-		/**
-		 * 创建指针变量 next_bullet_node 原因：
-		 * 见函数 enemy_move() 中 next_enemy_node 定义处的注释。
-		 */
-		Node* next_bullet_node = bullet_node->next;
-		Object* bullet = (Object*)bullet_node->data;
-
-		bullet->y -= bullet_speed[difficulty];
-		if (bullet->y < -BULLET_HEIGHT) {
-			list_random_erase(bullet_list, bullet_node);
-
-			fprintf(stdout, "A bullet has been erased. (out of bound)\n");
-		}
-
-		bullet_node = next_bullet_node;
+void stress_report(const double step_seconds) {
+	static int ticks = 0;
+	static size_t entities = 0;
+	static double seconds = 0, max_seconds = 0;
+	static unsigned long long frames = 0;
+
+	entities += world_object_count(&world);
+	seconds += step_seconds;
+	max_seconds = step_seconds > max_seconds ? step_seconds : max_seconds;
+	if (++ticks < WORLD_TICK_RATE) {
+		return;
 	}
+
+	const unsigned long long frame_count = render_thread_frame_count();
+	LOG_INFO("Stress: %zu entities, %.2f ms per tick (max %.2f ms), %llu FPS.",
+		entities / ticks, seconds * 1000 / ticks, max_seconds * 1000, frame_count - frames);
+	frames = frame_count;
+	ticks = 0;
+	entities = 0;
+	seconds = max_seconds = 0;
 }
 
 /**
- * @brief 对所有敌机，判断其是否被子弹击中。
+ * @brief 每局使用的参数。
  */
-void enemy_bullet_collision() {
-	for (Node* enemy_node = enemy_list->head->next; enemy_node; ) {
-		/**
-		 * 创建指针变量 next_enemy_node 原因：
-		 * 见函数 enemy_move() 中 next_enemy_node 定义处的注释。
-		 */
-		Node* next_enemy_node = enemy_node->next;
-		Object* enemy = (Object*)enemy_node->data;
-
-		for (Node* bullet_node = bullet_list->head->next; bullet_node; ) {
-			/**
-			 * 创建指针变量 next_bullet_node 原因：
-			 * 见函数 enemy_move() 中 next_enemy_node 定义处的注释。
-			 */
-			Node* next_bullet_node = bullet_node->next;
-			Object* bullet = (Object*)bullet_node->data;
-
-			if (object_collision(enemy, bullet)) {
-				list_random_erase(enemy_list, enemy_node);
-				list_random_erase(bullet_list, bullet_node);
-
-				fprintf(stdout, "A bullet has been erased. (collision with enemy)\n");
-				fprintf(stdout, "An enemy has been erased. (collision with bullet)\n");
-
-				game_control_add_score(&game_control_data, POINTS_PER_HIT);
-
-				break; // 不再与其他子弹进行碰撞判断。
-			}
-
-			bullet_node = next_bullet_node;
-		}
+WorldParams session_params() {
+	if (stress_entities == 0) {
+		return world_default_params(difficulty);
+	}
 
-		enemy_node = next_enemy_node;
+	WorldParams params = world_stress_params(stress_entities);
+	if (stress_bullets_per_shot > 0) {
+		params.bullets_per_shot = stress_bullets_per_shot;
+	}
+	if (stress_spread >= 0) {
+		params.bullet_spread = stress_spread;
 	}
+	if (stress_enemies_per_spawn > 0) {
+		params.enemies_per_spawn = stress_enemies_per_spawn;
+	}
+	return params;
 }
 
 /**
- * @brief 对所有敌机，判断其是否与玩家碰撞。
+ * @brief 解析命令行。
  */
-void enemy_player_collision() {
-	for (Node* enemy_node = enemy_list->head->next; enemy_node; ) {
-		/**
-		 * 创建指针变量 next_enemy_node 原因：
-		 * 见函数 enemy_move() 中 next_enemy_node 定义处的注释。
-		 */
-		Node* next_enemy_node = enemy_node->next;
-		Object* enemy = (Object*)enemy_node->data;
-
-		if (object_collision(enemy, player)) {
-			list_random_erase(enemy_list, enemy_node);
-
-			fprintf(stdout, "An enemy has been erased. (collision with player)\n");
-
-			game_control_reduce_hp(&game_control_data, delta_hp[difficulty]);
+bool parse_arguments(const int argc, char* argv[]) {
+	bool limited = false, overridden = false;
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--bot")) {
+			bot_enabled = true;
+		}
+		else if (!strcmp(argv[i], "--ticks") && i + 1 < argc) {
+			bot_tick_limit = strtoull(argv[++i], NULL, 10);
+			limited = true;
 		}
+		else if (!strcmp(argv[i], "--minutes") && i + 1 < argc) {
+			bot_second_limit = atof(argv[++i]) * 60;
+			limited = true;
+		}
+		else if (!strcmp(argv[i], "--difficulty") && i + 1 < argc) {
+			difficulty = atoi(argv[++i]);
+			if (difficulty < 0 || difficulty >= DIFFICULTY_COUNT) {
+				fprintf(stderr, "Invalid difficulty %d.\n", difficulty);
+				return false;
+			}
+		}
+		else if (!strcmp(argv[i], "--stress") && i + 1 < argc) {
+			stress_entities = (size_t)strtoull(argv[++i], NULL, 10);
+		}
+		else if (!strcmp(argv[i], "--bullets-per-shot") && i + 1 < argc) {
+			stress_bullets_per_shot = atoi(argv[++i]);
+			overridden = true;
+		}
+		else if (!strcmp(argv[i], "--spread") && i + 1 < argc) {
+			stress_spread = atoi(argv[++i]);
+			overridden = true;
+		}
+		else if (!strcmp(argv[i], "--enemies-per-spawn") && i + 1 < argc) {
+			stress_enemies_per_spawn = atoi(argv[++i]);
+			overridden = true;
+		}
+		else {
+			fprintf(stderr, "Usage: %s [--difficulty D] [--bot [--ticks N] [--minutes N]] "
+				"[--stress N [--bullets-per-shot N] [--spread N] [--enemies-per-spawn N]]\n", argv[0]);
+			return false;
+		}
+	}
 
-		enemy_node = next_enemy_node;
+	if (limited && !bot_enabled) {
+		fprintf(stderr, "--ticks and --minutes require --bot.\n");
+		return false;
+	}
+	// 录像只记录难度，覆盖了参数的对局无法回放，因此只允许在压力测试中覆盖。
+	if (overridden && stress_entities == 0) {
+		fprintf(stderr, "--bullets-per-shot, --spread and --enemies-per-spawn require --stress.\n");
+		return false;
 	}
+	return true;
 }
 
 /**
- * @brief 初始化游戏对象。
+ * @brief 自动驾驶时每 BOT_REPORT_TICKS 个 tick 在日志中报告一次对局数、帧耗时、帧率与进程的内存占用。
  */
-void object_init() {
-	player = (Object*)malloc(sizeof(Object));
-	if (!player) {
-		fprintf(stderr, "malloc() failed.\n");
-		exit(EXIT_FAILURE);
+bool bot_report() {
+	static unsigned long long frames = 0;
+
+	++bot_ticks;
+	const bool finished = (bot_tick_limit > 0 && bot_ticks >= bot_tick_limit) ||
+		(bot_second_limit > 0 && timer_now() - bot_begin_time >= bot_second_limit);
+	if (bot_ticks % BOT_REPORT_TICKS != 0 && !finished) {
+		return finished;
 	}
 
-	player->x = SCREEN_WIDTH / 2 - PLAYER_WIDTH / 2;
-	player->y = SCREEN_HEIGHT - PLAYER_HEIGHT - 100;
-	player->type = PLAYER;
-
-	enemy_list = list_init();
-	bullet_list = list_init();
-
-	last_bullet_spawn_time = last_enemy_spawn_time = clock();
+	PROCESS_MEMORY_COUNTERS memory = {};
+	memory.cb = sizeof(memory);
+	GetProcessMemoryInfo(GetCurrentProcess(), &memory, sizeof(memory));
+
+	const ProfilerStats frame = profiler_stats(PROFILE_FRAME);
+	const unsigned long long frame_count = render_thread_frame_count();
+	LOG_INFO("Bot: %llu ticks, %zu sessions, frame %.2f ms (p99 %.2f ms, max %.2f ms), %llu frames drawn, "
+		"working set %zu KiB (peak %zu KiB), arena %zu KiB.",
+		bot_ticks, session_count, frame.mean, frame.p99, frame.max, frame_count - frames,
+		(size_t)(memory.WorkingSetSize / 1024), (size_t)(memory.PeakWorkingSetSize / 1024), world.arena.reserved / 1024);
+	frames = frame_count;
+	return finished;
 }
 
 /**
- * @brief 对当前帧，处理所有游戏对象的移动、添加、删除等操作。
+ * @brief 开始一局新游戏：用新的随机数种子初始化模拟状态，并开始录制录像。参数见 session_params()。
+ *        第一局之后不再申请内存，而是 O(1) 地重置上一局的内存区域，重新开始的耗时与上一局存活的对象数无关。
  */
-void object_update() {
-
-	player_move();
-
-	// 检查开火键（空格键）是否被按下。
-	if (GetAsyncKeyState(VK_SPACE) & 0x8000) {
-		const clock_t fire_time = clock();
-		const double fire_gap = (double)(fire_time - last_bullet_spawn_time) / CLOCKS_PER_SEC;
-
-		// 检查本次开火与上次开火的时间间隔是否足够。
-		if (fire_gap >= min_fire_gap[difficulty]) {
-			player_fire();
-			last_bullet_spawn_time = fire_time; // 更新最后一次子弹生成时间。
+void session_start() {
+	const uint64_t seed = (uint64_t)time(NULL) ^ (uint64_t)(timer_now() * 1e6);
+	const WorldParams params = session_params();
 
-			fprintf(stdout, "A bullet has been fired.\n");
-			// 给出开火成功成功的反馈，如音效等。
-		}
+	if (world.player) {
+		world_restart(&world, difficulty, &params, seed);
 	}
-
-	const clock_t enemy_spawn_time = clock();
-	const double enemy_spawn_gap = (double)(enemy_spawn_time - last_enemy_spawn_time) / CLOCKS_PER_SEC;
-
-	// 检查本次敌机生成与上次敌机生成的时间间隔是否足够。
-	if (enemy_spawn_gap >= min_enemy_spawn_gap[difficulty]) {
-		enemy_spawn();
-		last_enemy_spawn_time = enemy_spawn_time; // 更新最后一次敌机生成时间。
-
-		fprintf(stdout, "An enemy has been spawned.\n");
+	else {
+		world_init_with_params(&world, &game_control_data, difficulty, &params, seed);
 	}
+	replay_init(&replay, seed, difficulty);
+	game_control_start(&game_control_data, world.starting_hp);
+	++session_count;
 
-	enemy_move();
-	bullet_move();
-	enemy_bullet_collision();
-	enemy_player_collision();
+	// 丢弃上一局的快照，渲染线程恢复后从这一局的初始状态开始绘制。
+	snapshot_reset();
+	snapshot_publish(&world);
 }
 
 /**
- * @brief 释放游戏对象的内存。
+ * @brief 结束当前这局游戏：保存录像。录像只记录难度，压力测试的对局无法回放，因此不保存。
  */
-void object_free() {
-	list_free(enemy_list);
-	list_free(bullet_list);
-	enemy_list = bullet_list = NULL;
-
-	if (player) {
-		free(player);
+void session_end() {
+	if (stress_entities == 0) {
+		replay_save(&replay, REPLAY_FILE);
 	}
-	player = NULL;
+	replay_free(&replay);
 }
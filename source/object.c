@@ -16,7 +16,8 @@
 typedef enum ObjectType {
 	PLAYER,
 	ENEMY,
-	BULLET
+	BULLET,
+	OBJECT_TYPE_COUNT
 } ObjectType;
 
 /**
@@ -24,64 +25,28 @@ typedef enum ObjectType {
  */
 typedef struct Object {
 	int x, y; // 游戏对象左上角位置坐标，单位：像素
+	int prev_x, prev_y; // 上一 tick 的左上角位置坐标，供渲染时插值使用
 	ObjectType type;
 } Object;
 
 #endif /* OBJECT_H */
 
+const ObjectKind object_kinds[OBJECT_TYPE_COUNT] = {
+	{ "player", PLAYER_WIDTH, PLAYER_HEIGHT, 0, 1, 0, 0 },
+	{ "enemy", ENEMY_WIDTH, ENEMY_HEIGHT, 1, 1, POINTS_PER_HIT, 1 },
+	{ "bullet", BULLET_WIDTH, BULLET_HEIGHT, 1, 1, 0, 2 }
+};
+
 /**
- * @brief 判断游戏对象是否碰撞。
+ * @brief 判断游戏对象是否碰撞。对象的宽高直接查表得到，需要保证传入的指针有效。
  */
 bool object_collision(const Object* obj1, const Object* obj2) {
-	if (!obj1 || !obj2) {
-		fprintf(stderr, "Invalid object pointer.\n");
-		return false;
-	}
-
-	// 推导对象的宽高
-	int width1, height1, width2, height2;
-	switch (obj1->type) {
-	case PLAYER:
-		width1 = PLAYER_WIDTH;
-		height1 = PLAYER_HEIGHT;
-		break;
-	case ENEMY:
-		width1 = ENEMY_WIDTH;
-		height1 = ENEMY_HEIGHT;
-		break;
-	case BULLET:
-		width1 = BULLET_WIDTH;
-		height1 = BULLET_HEIGHT;
-		break;
-	default:
-		fprintf(stderr, "Object type error.\n");
-		return false;
-	}
-
-	switch (obj2->type) {
-	case PLAYER:
-		width2 = PLAYER_WIDTH;
-		height2 = PLAYER_HEIGHT;
-		break;
-	case ENEMY:
-		width2 = ENEMY_WIDTH;
-		height2 = ENEMY_HEIGHT;
-		break;
-	case BULLET:
-		width2 = BULLET_WIDTH;
-		height2 = BULLET_HEIGHT;
-		break;
-	default:
-		fprintf(stderr, "Object type error.\n");
-		return false;
-	}
-
-	if (obj1->x < obj2->x + width2 &&
-		obj1->x + width1 > obj2->x &&
-		obj1->y < obj2->y + height2 &&
-		obj1->y + height1 > obj2->y) {
-		return true;
-	}
-
-	return false;
+	const int width1 = object_kinds[obj1->type].width, height1 = object_kinds[obj1->type].height;
+	const int width2 = object_kinds[obj2->type].width, height2 = object_kinds[obj2->type].height;
+
+	// 使用按位与而非逻辑与，避免短路求值引入分支。
+	return (obj1->x < obj2->x + width2) &
+		(obj1->x + width1 > obj2->x) &
+		(obj1->y < obj2->y + height2) &
+		(obj1->y + height1 > obj2->y);
 }
@@ -21,18 +21,39 @@ extern "C" {
 #define ENEMY_HEIGHT 50
 #define BULLET_WIDTH 10
 #define BULLET_HEIGHT 20
+#define POINTS_PER_HIT 10
 
 	typedef enum ObjectType {
 		PLAYER,
 		ENEMY,
-		BULLET
+		BULLET,
+		OBJECT_TYPE_COUNT
 	} ObjectType;
 
+	/**
+	 * @brief 一类对象共有的组件。每个对象各自的组件（位置、速度、生命值）存放在对象池的数组中，
+	 *        同一类对象共有的组件只存一份，以 ObjectType 为下标查表，取代按类型分支的推导。
+	 *        新增一类对象只需在 ObjectType 与 object_kinds 中各加一项，再在 world.c 的 collision_rules 中写明它与谁相撞；
+	 *        对象池的容量（WorldParams 中的 capacity）、移动、碰撞、快照与绘制都按类型循环，不需要改动。
+	 *        它使用新的贴图时，还要在 render_backend.h 的 RenderSpriteId 中加一项，并让各后端加载这张贴图。
+	 */
+	typedef struct ObjectKind {
+		const char* name; // 用于日志
+		int width, height; // 碰撞盒
+		int health; // 生成时的生命值。玩家的生命值由 GameControlData 记录，不使用这一项
+		int damage; // 碰撞时对对方造成的伤害
+		int points; // 被玩家的子弹消灭时的得分
+		int sprite; // 绘制时使用的贴图，即 render_backend.h 中的 RenderSpriteId
+	} ObjectKind;
+
+	extern const ObjectKind object_kinds[OBJECT_TYPE_COUNT];
+
 	/**
 	 * @brief 游戏对象，表示游戏中的各种实体。无需单独储存每个对象的宽高，而通过对象的类型推导，使用预定义的常量。
 	 */
 	typedef struct Object {
 		int x, y; // 游戏对象左上角位置坐标，单位：像素
+		int prev_x, prev_y; // 上一 tick 的左上角位置坐标，供渲染时插值使用
 		ObjectType type;
 	} Object;
 
@@ -0,0 +1,299 @@
+/**
+ * @file pool.c
+ * @brief 这份源文件实现了固定容量的游戏对象池，以及移动与剔除内核的标量、SSE2 与 AVX2 版本。
+ *        剔除时不做交换删除，而是把存活对象依次写到数组前部的写入位置 out 处：out 永远不超过读取位置，
+ *        因此写入只会覆盖已经读取过的数据，一趟遍历即可得到紧凑且保持原有顺序的存活对象。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pool.h"
+#include "jobs.h"
+
+#ifdef COLLISION_HAVE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef COLLISION_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
+#define POOL_FIELDS 6 // x, y, vx, vy, type, hp
+#define POOL_PARALLEL_GRAIN 8192 // 并行移动时每块至少包含的对象数。对象较少时调度开销超过收益，整趟在调用线程上完成
+#define POOL_MAX_CHUNKS 64 // 并行移动时的块数上限
+
+/**
+ * @brief 初始化对象池，一次性分配 capacity 个对象的空间。所有字段共用一块内存。
+ */
+void pool_init(ObjectPool* pool, const size_t capacity, Arena* arena) {
+	const size_t slots = capacity ? capacity : 1;
+	int* block = (int*)arena_alloc(arena, sizeof(int) * POOL_FIELDS * slots);
+
+	pool->x = block;
+	pool->y = block + slots;
+	pool->vx = block + slots * 2;
+	pool->vy = block + slots * 3;
+	pool->type = block + slots * 4;
+	pool->hp = block + slots * 5;
+	pool->count = 0;
+	pool->capacity = capacity;
+}
+
+/**
+ * @brief O(1) 在池尾追加一个对象，池已满时返回 false。
+ */
+bool pool_spawn(ObjectPool* pool, const int x, const int y, const int vx, const int vy, const ObjectType type) {
+	if (pool->count == pool->capacity) {
+		return false;
+	}
+
+	const size_t i = pool->count++;
+	pool->x[i] = x;
+	pool->y[i] = y;
+	pool->vx[i] = vx;
+	pool->vy[i] = vy;
+	pool->type[i] = (int)type;
+	pool->hp[i] = object_kinds[type].health;
+	return true;
+}
+
+/**
+ * @brief O(1) 删除下标为 index 的对象：用最后一个存活对象填补空位。
+ */
+void pool_erase(ObjectPool* pool, const size_t index) {
+	const size_t last = --pool->count;
+	pool->x[index] = pool->x[last];
+	pool->y[index] = pool->y[last];
+	pool->vx[index] = pool->vx[last];
+	pool->vy[index] = pool->vy[last];
+	pool->type[index] = pool->type[last];
+	pool->hp[index] = pool->hp[last];
+}
+
+/**
+ * @brief 用标量代码处理下标 [begin, end) 的对象，存活对象从 out 处开始写入。
+ *        每个对象都无条件写入 out 处，只有存活时 out 才前进，因此没有分支。
+ * @return 处理完后的写入位置。
+ */
+static size_t pool_integrate_tail(ObjectPool* pool, const size_t begin, const size_t end, size_t out,
+	const int min_x, const int min_y, const int max_x, const int max_y) {
+	for (size_t i = begin; i < end; ++i) {
+		const int vx = pool->vx[i], vy = pool->vy[i];
+		const int type = pool->type[i], hp = pool->hp[i];
+		const int x = pool->x[i] + vx, y = pool->y[i] + vy;
+
+		pool->x[out] = x;
+		pool->y[out] = y;
+		pool->vx[out] = vx;
+		pool->vy[out] = vy;
+		pool->type[out] = type;
+		pool->hp[out] = hp;
+		out += (size_t)((x >= min_x) & (x <= max_x) & (y >= min_y) & (y <= max_y));
+	}
+	return out;
+}
+
+static size_t pool_integrate_range_scalar(ObjectPool* pool, const size_t begin, const size_t end,
+	const int min_x, const int min_y, const int max_x, const int max_y) {
+	return pool_integrate_tail(pool, begin, end, begin, min_x, min_y, max_x, max_y);
+}
+
+#ifdef COLLISION_HAVE_SSE2
+static size_t pool_integrate_range_sse2(ObjectPool* pool, const size_t begin, const size_t end,
+	const int min_x, const int min_y, const int max_x, const int max_y) {
+	const __m128i low_x = _mm_set1_epi32(min_x), high_x = _mm_set1_epi32(max_x);
+	const __m128i low_y = _mm_set1_epi32(min_y), high_y = _mm_set1_epi32(max_y);
+
+	size_t i = begin, out = begin;
+	for (; i + 4 <= end; i += 4) {
+		const __m128i vx = _mm_loadu_si128((const __m128i*)(pool->vx + i));
+		const __m128i vy = _mm_loadu_si128((const __m128i*)(pool->vy + i));
+		const __m128i x = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(pool->x + i)), vx);
+		const __m128i y = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(pool->y + i)), vy);
+		const __m128i outside = _mm_or_si128(
+			_mm_or_si128(_mm_cmplt_epi32(x, low_x), _mm_cmpgt_epi32(x, high_x)),
+			_mm_or_si128(_mm_cmplt_epi32(y, low_y), _mm_cmpgt_epi32(y, high_y)));
+
+		if (_mm_movemask_ps(_mm_castsi128_ps(outside)) == 0) {
+			// 绝大多数情况下 4 个对象都存活，整组写入即可；尚未有对象被剔除时，只有坐标需要写回。
+			_mm_storeu_si128((__m128i*)(pool->x + out), x);
+			_mm_storeu_si128((__m128i*)(pool->y + out), y);
+			if (out != i) {
+				_mm_storeu_si128((__m128i*)(pool->vx + out), vx);
+				_mm_storeu_si128((__m128i*)(pool->vy + out), vy);
+				_mm_storeu_si128((__m128i*)(pool->type + out), _mm_loadu_si128((const __m128i*)(pool->type + i)));
+				_mm_storeu_si128((__m128i*)(pool->hp + out), _mm_loadu_si128((const __m128i*)(pool->hp + i)));
+			}
+			out += 4;
+		}
+		else {
+			// SSE2 没有按变量重排的指令，有对象被剔除时退回标量代码处理这一组。
+			out = pool_integrate_tail(pool, i, i + 4, out, min_x, min_y, max_x, max_y);
+		}
+	}
+
+	return pool_integrate_tail(pool, i, end, out, min_x, min_y, max_x, max_y);
+}
+#endif
+
+#ifdef COLLISION_HAVE_AVX2
+static size_t pool_integrate_range_avx2(ObjectPool* pool, const size_t begin, const size_t end,
+	const int min_x, const int min_y, const int max_x, const int max_y) {
+	const __m256i low_x = _mm256_set1_epi32(min_x), high_x = _mm256_set1_epi32(max_x);
+	const __m256i low_y = _mm256_set1_epi32(min_y), high_y = _mm256_set1_epi32(max_y);
+	const __m256i nibble_shift = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+
+	size_t i = begin, out = begin;
+	for (; i + 8 <= end; i += 8) {
+		const __m256i vx = _mm256_loadu_si256((const __m256i*)(pool->vx + i));
+		const __m256i vy = _mm256_loadu_si256((const __m256i*)(pool->vy + i));
+		const __m256i x = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(pool->x + i)), vx);
+		const __m256i y = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)(pool->y + i)), vy);
+		const __m256i outside = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpgt_epi32(low_x, x), _mm256_cmpgt_epi32(x, high_x)),
+			_mm256_or_si256(_mm256_cmpgt_epi32(low_y, y), _mm256_cmpgt_epi32(y, high_y)));
+		const int keep = ~_mm256_movemask_ps(_mm256_castsi256_ps(outside)) & 0xFF;
+
+		if (keep == 0xFF) {
+			// 8 个对象都存活时整组写入；尚未有对象被剔除时，只有坐标需要写回。
+			_mm256_storeu_si256((__m256i*)(pool->x + out), x);
+			_mm256_storeu_si256((__m256i*)(pool->y + out), y);
+			if (out != i) {
+				_mm256_storeu_si256((__m256i*)(pool->vx + out), vx);
+				_mm256_storeu_si256((__m256i*)(pool->vy + out), vy);
+				_mm256_storeu_si256((__m256i*)(pool->type + out), _mm256_loadu_si256((const __m256i*)(pool->type + i)));
+				_mm256_storeu_si256((__m256i*)(pool->hp + out), _mm256_loadu_si256((const __m256i*)(pool->hp + i)));
+			}
+			out += 8;
+			continue;
+		}
+
+		/**
+		 * 依次列出存活通道的下标，每个下标占 4 位，再展开为重排用的 8 个通道。
+		 * 只有对象离开屏幕的那一组才会走到这里，因此现算即可，不需要查找表，也就没有需要在多线程间共享初始化的全局状态。
+		 * 把存活的通道重排到前部后整组写入；多写的通道位于 [out + n, out + 8)，不超过 i + 8，会被后续写入覆盖。
+		 */
+		unsigned packed = 0;
+		int n = 0;
+		for (int lane = 0; lane < 8; ++lane) {
+			if (keep >> lane & 1) {
+				packed |= (unsigned)lane << (4 * n++);
+			}
+		}
+		const __m256i permutation = _mm256_srlv_epi32(_mm256_set1_epi32((int)packed), nibble_shift);
+		const __m256i type = _mm256_loadu_si256((const __m256i*)(pool->type + i));
+		const __m256i hp = _mm256_loadu_si256((const __m256i*)(pool->hp + i));
+		_mm256_storeu_si256((__m256i*)(pool->x + out), _mm256_permutevar8x32_epi32(x, permutation));
+		_mm256_storeu_si256((__m256i*)(pool->y + out), _mm256_permutevar8x32_epi32(y, permutation));
+		_mm256_storeu_si256((__m256i*)(pool->vx + out), _mm256_permutevar8x32_epi32(vx, permutation));
+		_mm256_storeu_si256((__m256i*)(pool->vy + out), _mm256_permutevar8x32_epi32(vy, permutation));
+		_mm256_storeu_si256((__m256i*)(pool->type + out), _mm256_permutevar8x32_epi32(type, permutation));
+		_mm256_storeu_si256((__m256i*)(pool->hp + out), _mm256_permutevar8x32_epi32(hp, permutation));
+		out += (size_t)n;
+	}
+
+	return pool_integrate_tail(pool, i, end, out, min_x, min_y, max_x, max_y);
+}
+#endif
+
+/**
+ * @brief 用当前编译条件下最快的实现处理下标 [begin, end) 的对象，存活对象紧凑地写在 begin 处。
+ * @return 处理完后的写入位置。
+ */
+static size_t pool_integrate_range(ObjectPool* pool, const size_t begin, const size_t end,
+	const int min_x, const int min_y, const int max_x, const int max_y) {
+#if defined(COLLISION_HAVE_AVX2)
+	return pool_integrate_range_avx2(pool, begin, end, min_x, min_y, max_x, max_y);
+#elif defined(COLLISION_HAVE_SSE2)
+	return pool_integrate_range_sse2(pool, begin, end, min_x, min_y, max_x, max_y);
+#else
+	return pool_integrate_range_scalar(pool, begin, end, min_x, min_y, max_x, max_y);
+#endif
+}
+
+size_t pool_integrate_scalar(ObjectPool* pool, const int min_x, const int min_y, const int max_x, const int max_y) {
+	const size_t count = pool->count;
+	pool->count = pool_integrate_range_scalar(pool, 0, count, min_x, min_y, max_x, max_y);
+	return count - pool->count;
+}
+
+#ifdef COLLISION_HAVE_SSE2
+size_t pool_integrate_sse2(ObjectPool* pool, const int min_x, const int min_y, const int max_x, const int max_y) {
+	const size_t count = pool->count;
+	pool->count = pool_integrate_range_sse2(pool, 0, count, min_x, min_y, max_x, max_y);
+	return count - pool->count;
+}
+#endif
+
+#ifdef COLLISION_HAVE_AVX2
+size_t pool_integrate_avx2(ObjectPool* pool, const int min_x, const int min_y, const int max_x, const int max_y) {
+	const size_t count = pool->count;
+	pool->count = pool_integrate_range_avx2(pool, 0, count, min_x, min_y, max_x, max_y);
+	return count - pool->count;
+}
+#endif
+
+/**
+ * @brief 并行移动与剔除时一次调用的参数，以及每一块处理完后的写入位置。
+ */
+typedef struct PoolIntegrateJob {
+	ObjectPool* pool;
+	int min_x, min_y, max_x, max_y;
+	size_t end[POOL_MAX_CHUNKS];
+} PoolIntegrateJob;
+
+static void pool_integrate_chunk(void* context, const size_t begin, const size_t end, const size_t chunk) {
+	PoolIntegrateJob* job = (PoolIntegrateJob*)context;
+	job->end[chunk] = pool_integrate_range(job->pool, begin, end, job->min_x, job->min_y, job->max_x, job->max_y);
+}
+
+/**
+ * @brief 每一块先在自己的下标区间内就地紧凑化，再按块号依次把各块的存活对象前移拼接。
+ *        块内与块间都保持原有顺序，因此结果与串行的一趟遍历完全相同，与线程数无关。
+ */
+size_t pool_integrate(ObjectPool* pool, const int min_x, const int min_y, const int max_x, const int max_y) {
+	const size_t count = pool->count;
+	const size_t grain = jobs_grain(count, POOL_PARALLEL_GRAIN, POOL_MAX_CHUNKS);
+
+	PoolIntegrateJob job;
+	job.pool = pool;
+	job.min_x = min_x;
+	job.min_y = min_y;
+	job.max_x = max_x;
+	job.max_y = max_y;
+	const size_t chunks = jobs_parallel_for(count, grain, pool_integrate_chunk, &job);
+
+	size_t out = chunks ? job.end[0] : 0;
+	for (size_t c = 1; c < chunks; ++c) {
+		const size_t begin = c * grain, survivors = job.end[c] - begin;
+		if (survivors && out != begin) {
+			int* const fields[POOL_FIELDS] = { pool->x, pool->y, pool->vx, pool->vy, pool->type, pool->hp };
+			for (int f = 0; f < POOL_FIELDS; ++f) {
+				memmove(fields[f] + out, fields[f] + begin, sizeof(int) * survivors);
+			}
+		}
+		out += survivors;
+	}
+
+	pool->count = out;
+	return count - out;
+}
+
+/**
+ * @brief O(1) 删除池中的所有对象，但不释放空间。
+ */
+void pool_clear(ObjectPool* pool) {
+	pool->count = 0;
+}
+
+/**
+ * @brief 释放用 malloc() 分配的对象池。
+ */
+void pool_free(ObjectPool* pool) {
+	free(pool->x);
+	pool->x = pool->y = pool->vx = pool->vy = pool->type = pool->hp = NULL;
+	pool->count = pool->capacity = 0;
+}
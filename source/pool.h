@@ -0,0 +1,91 @@
+/**
+ * @file pool.h
+ * @brief 这份头文件声明了固定容量的游戏对象池。对象按结构体数组（SoA）存放：每个字段各占一个连续数组，
+ *        移动、剔除与碰撞判断都只顺序读写自己需要的字段，便于用 SIMD 一次处理多个对象。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "object.h"
+#include "collision.h"
+#include "arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef POOL_H
+#define POOL_H
+
+	/**
+	 * @brief 对象池。各数组的下标 [0, count) 为存活对象，[count, capacity) 为空闲槽位，
+	 *        新对象总是追加在存活对象之后，因此池初始化之后不再有任何内存分配。
+	 */
+	typedef struct ObjectPool {
+		int* x; // 左上角横坐标，单位：像素
+		int* y; // 左上角纵坐标，单位：像素
+		int* vx; // 速度，单位：像素每 tick。上一 tick 的坐标即为 (x - vx, y - vy)，渲染插值无需另存
+		int* vy;
+		int* type; // ObjectType，与坐标同宽，便于 SIMD 整组搬移
+		int* hp; // 生命值，生成时取自 object_kinds
+		size_t count;
+		size_t capacity;
+	} ObjectPool;
+
+	/**
+	 * @brief 初始化对象池，一次性分配 capacity 个对象的空间。空间从 arena 中划分，随 arena 一起重置与释放；
+	 *        arena 为 NULL 时用 malloc() 分配，须调用 pool_free() 释放。
+	 */
+	void pool_init(ObjectPool* pool, const size_t capacity, Arena* arena);
+
+	/**
+	 * @brief O(1) 在池尾追加一个对象，生命值取自这类对象的 ObjectKind。
+	 * @return 池已满时返回 false，调用者应放弃本次生成。
+	 */
+	bool pool_spawn(ObjectPool* pool, const int x, const int y, const int vx, const int vy, const ObjectType type);
+
+	/**
+	 * @brief O(1) 删除下标为 index 的对象：用最后一个存活对象填补空位。
+	 *        因此遍历时若删除了当前对象，不应递增下标，而应继续处理被换到当前位置的对象。
+	 */
+	void pool_erase(ObjectPool* pool, const size_t index);
+
+	/**
+	 * @brief 推进所有对象一个 tick：按速度移动，
+	 *        并在同一趟遍历中删除移动后左上角不在 [min_x, max_x] × [min_y, max_y] 内的对象。
+	 *        存活对象保持原有的相对顺序，紧凑地排在数组前部。编译器开启 SSE2 / AVX2 时自动选用对应的 SIMD 实现；
+	 *        对象足够多且任务调度器已启动时分块并行处理，结果与串行处理逐位一致。
+	 * @return 被删除的对象数量。
+	 */
+	size_t pool_integrate(ObjectPool* pool, const int min_x, const int min_y, const int max_x, const int max_y);
+
+	// 以下为各个具体实现，参数与返回值同 pool_integrate()，可用于验证各实现的结果是否一致。
+
+	size_t pool_integrate_scalar(ObjectPool* pool, const int min_x, const int min_y, const int max_x, const int max_y);
+
+#ifdef COLLISION_HAVE_SSE2
+	size_t pool_integrate_sse2(ObjectPool* pool, const int min_x, const int min_y, const int max_x, const int max_y);
+#endif
+
+#ifdef COLLISION_HAVE_AVX2
+	size_t pool_integrate_avx2(ObjectPool* pool, const int min_x, const int min_y, const int max_x, const int max_y);
+#endif
+
+	/**
+	 * @brief O(1) 删除池中的所有对象，但不释放空间。
+	 */
+	void pool_clear(ObjectPool* pool);
+
+	/**
+	 * @brief 释放用 malloc() 分配的对象池。从 arena 中划分的对象池不需要释放。
+	 */
+	void pool_free(ObjectPool* pool);
+
+#endif /* POOL_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,304 @@
+/**
+ * @file profiler.cpp
+ * @brief 这份源文件实现了逐帧的分阶段性能分析器。
+ *        每个阶段保存最近 PROFILER_WINDOW 帧的耗时，新的一帧进入窗口时，把被挤出的那一帧从直方图中减去，
+ *        因此统计始终只反映最近的帧，开销与窗口长度无关。
+ *        阶段的开始时间按线程分别保存；累加耗时、写入 trace 事件与读取统计由一把互斥锁保护，只有启用时才会加锁。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <atomic>
+#include <mutex>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "profiler.h"
+#include "timer.h"
+#include "log.h"
+
+#define PROFILER_SQRT1_2 0.70710678118654752440 // 1 / √2，桶的分界
+
+/**
+ * @brief 一个阶段的滚动窗口。
+ */
+typedef struct PhaseWindow {
+	double samples[PROFILER_WINDOW]; // 环形缓冲区，单位：秒
+	unsigned buckets[PROFILER_BUCKETS];
+	double sum;
+} PhaseWindow;
+
+/**
+ * @brief 一条 Chrome trace 的完整事件（"ph": "X"）。
+ */
+typedef struct TraceEvent {
+	double start; // 单位：秒，相对于开始记录的时刻
+	double duration;
+	ProfilerPhase phase;
+	int thread; // 记录事件的线程编号，从 1 开始，对应 trace 中的 tid
+} TraceEvent;
+
+static std::mutex g_profiler_mutex; // 保护以下除开始时间以外的所有状态
+static std::atomic<bool> g_profiler_overlay(false);
+static std::atomic<bool> g_profiler_enabled(false); // 叠加层显示或正在导出
+static std::atomic<unsigned> g_profiler_epoch(0); // 每次启用时递增，使启用之前开始的计时失效
+static std::atomic<int> g_profiler_threads(0); // 已记录过事件的线程数
+static thread_local double t_phase_start[PROFILE_PHASE_COUNT];
+static thread_local unsigned t_phase_epoch[PROFILE_PHASE_COUNT]; // 开始计时时的 g_profiler_epoch，0 表示未在计时
+static thread_local int t_profiler_thread = 0;
+static double g_frame_time[PROFILE_PHASE_COUNT]; // 本帧各阶段的累计耗时，单位：秒
+static PhaseWindow g_windows[PROFILE_PHASE_COUNT];
+static size_t g_frame_count = 0; // 已汇入窗口的帧数
+static size_t g_window_position = 0;
+
+static TraceEvent* g_trace_events = NULL;
+static size_t g_trace_count = 0;
+static double g_trace_origin = 0;
+static char g_trace_path[512];
+
+static const char* const phase_names[PROFILE_PHASE_COUNT] = {
+	"frame", "input", "move", "spawn", "collision_bullet", "collision_player",
+	"render_background", "render_sprites", "render_hud", "render_present", "sleep"
+};
+
+/**
+ * @brief 根据叠加层与导出的状态启用或停用计时。调用者须持有 g_profiler_mutex。
+ */
+static void profiler_update_enabled() {
+	const bool enabled = g_profiler_overlay.load() || g_trace_events != NULL;
+	if (enabled && !g_profiler_enabled.load()) {
+		for (int i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+			g_frame_time[i] = 0;
+		}
+		g_profiler_epoch.fetch_add(1);
+	}
+	g_profiler_enabled.store(enabled);
+}
+
+/**
+ * @brief 耗时所在的直方图桶：把微秒数写成 m * 2^e（m 属于 [0.5, 1)），桶号为 2e，m >= 1/√2 时再加 1。
+ */
+static int bucket_of(const double seconds) {
+	const double microseconds = seconds * 1e6;
+	if (microseconds < 1) {
+		return 0;
+	}
+
+	int exponent;
+	const double mantissa = frexp(microseconds, &exponent);
+	const int bucket = 2 * exponent + (mantissa >= PROFILER_SQRT1_2);
+	return bucket < PROFILER_BUCKETS ? bucket : PROFILER_BUCKETS - 1;
+}
+
+/**
+ * @brief 直方图桶的上界，单位：秒。
+ */
+static double bucket_upper_bound(const int bucket) {
+	const double power = ldexp(1.0, bucket / 2);
+	return (bucket % 2 ? power : power * PROFILER_SQRT1_2) * 1e-6;
+}
+
+void profiler_begin(const ProfilerPhase phase) {
+	if (!g_profiler_enabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	t_phase_start[phase] = timer_now();
+	t_phase_epoch[phase] = g_profiler_epoch.load(std::memory_order_relaxed);
+}
+
+void profiler_end(const ProfilerPhase phase) {
+	if (!g_profiler_enabled.load(std::memory_order_relaxed) || t_phase_epoch[phase] != g_profiler_epoch.load(std::memory_order_relaxed)) {
+		return; // 计时开始时尚未启用。
+	}
+
+	const double now = timer_now();
+	const double duration = now - t_phase_start[phase];
+	t_phase_epoch[phase] = 0;
+	if (t_profiler_thread == 0) {
+		t_profiler_thread = g_profiler_threads.fetch_add(1) + 1;
+	}
+
+	std::lock_guard<std::mutex> lock(g_profiler_mutex);
+	g_frame_time[phase] += duration;
+
+	if (g_trace_events && g_trace_count < PROFILER_TRACE_CAPACITY) {
+		TraceEvent* event = &g_trace_events[g_trace_count++];
+		event->start = t_phase_start[phase] - g_trace_origin;
+		event->duration = duration;
+		event->phase = phase;
+		event->thread = t_profiler_thread;
+	}
+}
+
+void profiler_frame_end() {
+	if (!g_profiler_enabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(g_profiler_mutex);
+
+	for (int i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+		PhaseWindow* window = &g_windows[i];
+		if (g_frame_count >= PROFILER_WINDOW) {
+			const double evicted = window->samples[g_window_position];
+			--window->buckets[bucket_of(evicted)];
+			window->sum -= evicted;
+		}
+
+		window->samples[g_window_position] = g_frame_time[i];
+		++window->buckets[bucket_of(g_frame_time[i])];
+		window->sum += g_frame_time[i];
+		g_frame_time[i] = 0;
+	}
+
+	g_window_position = (g_window_position + 1) % PROFILER_WINDOW;
+	++g_frame_count;
+}
+
+void profiler_set_overlay(const bool visible) {
+	std::lock_guard<std::mutex> lock(g_profiler_mutex);
+	g_profiler_overlay.store(visible);
+	profiler_update_enabled();
+}
+
+bool profiler_overlay_visible() {
+	return g_profiler_overlay.load();
+}
+
+void profiler_trace_start(const char* path) {
+	std::lock_guard<std::mutex> lock(g_profiler_mutex);
+	if (g_trace_events) {
+		return;
+	}
+
+	g_trace_events = (TraceEvent*)malloc(PROFILER_TRACE_CAPACITY * sizeof(TraceEvent));
+	if (!g_trace_events) {
+		fprintf(stderr, "malloc() failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	snprintf(g_trace_path, sizeof(g_trace_path), "%s", path);
+	g_trace_count = 0;
+	g_trace_origin = timer_now();
+	profiler_update_enabled();
+
+	LOG_INFO("Profiler trace started: %s", g_trace_path);
+}
+
+static FILE* profiler_open(const char* path, const char* mode) {
+#if defined(_MSC_VER)
+	FILE* file = NULL;
+	if (fopen_s(&file, path, mode)) {
+		return NULL;
+	}
+	return file;
+#else
+	return fopen(path, mode);
+#endif
+}
+
+bool profiler_trace_stop() {
+	// 先在锁内取走已记录的事件并停止记录，再在锁外写文件，避免其他线程的计时等待磁盘。
+	TraceEvent* events;
+	size_t count;
+	{
+		std::lock_guard<std::mutex> lock(g_profiler_mutex);
+		if (!g_trace_events) {
+			return false;
+		}
+		events = g_trace_events;
+		count = g_trace_count;
+		g_trace_events = NULL;
+		profiler_update_enabled();
+	}
+
+	FILE* file = profiler_open(g_trace_path, "wb");
+	bool ok = file != NULL;
+	if (file) {
+		fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+		for (size_t i = 0; i < count; ++i) {
+			const TraceEvent* event = &events[i];
+			fprintf(file, "{\"name\": \"%s\", \"cat\": \"galaxy\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %d}%s\n",
+				phase_names[event->phase], event->start * 1e6, event->duration * 1e6, event->thread, i + 1 < count ? "," : "");
+		}
+		fprintf(file, "]}\n");
+		ok = !ferror(file);
+		fclose(file);
+	}
+
+	if (ok) {
+		LOG_INFO("Profiler trace saved: %s (%zu events%s)", g_trace_path, count,
+			count == PROFILER_TRACE_CAPACITY ? ", truncated" : "");
+	}
+	else {
+		LOG_WARN("Failed to write profiler trace %s.", g_trace_path);
+	}
+
+	free(events);
+	return ok;
+}
+
+bool profiler_trace_active() {
+	std::lock_guard<std::mutex> lock(g_profiler_mutex);
+	return g_trace_events != NULL;
+}
+
+/**
+ * @brief 同 profiler_history()，调用者须持有 g_profiler_mutex。
+ */
+static double profiler_history_locked(const ProfilerPhase phase, const size_t age) {
+	if (age >= g_frame_count || age >= PROFILER_WINDOW) {
+		return 0;
+	}
+	return g_windows[phase].samples[(g_window_position + PROFILER_WINDOW - 1 - age) % PROFILER_WINDOW] * 1e3;
+}
+
+ProfilerStats profiler_stats(const ProfilerPhase phase) {
+	std::lock_guard<std::mutex> lock(g_profiler_mutex);
+	ProfilerStats stats = {};
+	const PhaseWindow* window = &g_windows[phase];
+	const size_t count = g_frame_count < PROFILER_WINDOW ? g_frame_count : PROFILER_WINDOW;
+	if (count == 0) {
+		return stats;
+	}
+
+	double max = 0;
+	for (size_t i = 0; i < count; ++i) {
+		max = window->samples[i] > max ? window->samples[i] : max;
+	}
+
+	// 在直方图上累加，找到第一个累计帧数达到分位数的桶。
+	const size_t p50_rank = (count + 1) / 2;
+	const size_t p99_rank = count - count / 100;
+	double p50 = max, p99 = max;
+	size_t cumulative = 0;
+	for (int bucket = 0; bucket < PROFILER_BUCKETS; ++bucket) {
+		const size_t before = cumulative;
+		cumulative += window->buckets[bucket];
+		if (before < p50_rank && cumulative >= p50_rank) {
+			p50 = bucket_upper_bound(bucket);
+		}
+		if (before < p99_rank && cumulative >= p99_rank) {
+			p99 = bucket_upper_bound(bucket);
+			break;
+		}
+	}
+
+	stats.last = profiler_history_locked(phase, 0);
+	stats.mean = window->sum / count * 1e3;
+	stats.p50 = (p50 < max ? p50 : max) * 1e3;
+	stats.p99 = (p99 < max ? p99 : max) * 1e3;
+	stats.max = max * 1e3;
+	return stats;
+}
+
+double profiler_history(const ProfilerPhase phase, const size_t age) {
+	std::lock_guard<std::mutex> lock(g_profiler_mutex);
+	return profiler_history_locked(phase, age);
+}
+
+const char* profiler_phase_name(const ProfilerPhase phase) {
+	return phase >= 0 && phase < PROFILE_PHASE_COUNT ? phase_names[phase] : "?";
+}
@@ -0,0 +1,112 @@
+/**
+ * @file profiler.h
+ * @brief 这份头文件声明了逐帧的分阶段性能分析器。在各阶段前后放置计时标记，每帧各阶段的耗时汇入滚动窗口内的直方图，
+ *        可以由渲染器绘制为屏幕叠加层，也可以导出为 Chrome trace-event JSON（在 chrome://tracing 或 Perfetto 中打开）。
+ *        可以在多个线程中计时，同一阶段应始终在同一个线程中计时；trace 中每个线程各占一行。
+ *        未启用时每个计时标记只有一次分支的开销；定义 PROFILER_ENABLED 为 0 时计时标记完全不参与编译。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#define PROFILER_WINDOW 256 // 滚动窗口的帧数
+#define PROFILER_BUCKETS 48 // 直方图的桶数：每个 2 的幂区间分为 2 个桶，覆盖 1 微秒到约 8 秒
+#define PROFILER_TRACE_CAPACITY (1 << 20) // 一次导出最多记录的事件数，超出的事件被丢弃
+
+#if PROFILER_ENABLED
+#define PROFILE_BEGIN(phase) profiler_begin(phase)
+#define PROFILE_END(phase) profiler_end(phase)
+#else
+#define PROFILE_BEGIN(phase) ((void)0)
+#define PROFILE_END(phase) ((void)0)
+#endif
+
+	/**
+	 * @brief 一帧中被计时的各个阶段。同一阶段在一帧内可以出现多次（例如一帧补算多个 tick），耗时累加。
+	 */
+	typedef enum ProfilerPhase {
+		PROFILE_FRAME, // 游戏循环的一整次迭代
+		PROFILE_INPUT,
+		PROFILE_MOVE,
+		PROFILE_SPAWN, // 开火与敌机生成
+		PROFILE_COLLISION_BULLET, // 对象池之间的碰撞（子弹与敌机）
+		PROFILE_COLLISION_PLAYER, // 对象与玩家的碰撞以及删除被消灭的对象
+		PROFILE_RENDER_BACKGROUND,
+		PROFILE_RENDER_SPRITES,
+		PROFILE_RENDER_HUD,
+		PROFILE_RENDER_PRESENT, // FlushBatchDraw()
+		PROFILE_SLEEP,
+		PROFILE_PHASE_COUNT
+	} ProfilerPhase;
+
+	/**
+	 * @brief 某一阶段在滚动窗口内的统计，单位：毫秒。p50 与 p99 取自直方图，精度为所在桶的上界。
+	 */
+	typedef struct ProfilerStats {
+		double last;
+		double mean;
+		double p50;
+		double p99;
+		double max;
+	} ProfilerStats;
+
+	void profiler_begin(const ProfilerPhase phase);
+	void profiler_end(const ProfilerPhase phase);
+
+	/**
+	 * @brief 结束一帧：把本帧各阶段的耗时汇入滚动窗口。
+	 */
+	void profiler_frame_end();
+
+	/**
+	 * @brief 显示或隐藏屏幕叠加层。叠加层显示或正在导出时才会计时。
+	 */
+	void profiler_set_overlay(const bool visible);
+	bool profiler_overlay_visible();
+
+	/**
+	 * @brief 开始记录 Chrome trace 事件，调用 profiler_trace_stop() 时写入文件。
+	 */
+	void profiler_trace_start(const char* path);
+
+	/**
+	 * @brief 停止记录并写入文件。
+	 * @return 是否写入成功。
+	 */
+	bool profiler_trace_stop();
+	bool profiler_trace_active();
+
+	/**
+	 * @brief 取得某一阶段在滚动窗口内的统计。
+	 */
+	ProfilerStats profiler_stats(const ProfilerPhase phase);
+
+	/**
+	 * @brief 取得某一阶段在滚动窗口内第 age 帧之前的耗时（0 为最近一帧），单位：毫秒。用于绘制帧耗时曲线。
+	 */
+	double profiler_history(const ProfilerPhase phase, const size_t age);
+
+	/**
+	 * @brief 获取阶段的名称。
+	 */
+	const char* profiler_phase_name(const ProfilerPhase phase);
+
+#endif /* PROFILER_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
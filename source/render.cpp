@@ -10,23 +10,249 @@
 #include <windows.h>
 #include <graphics.h>
 #include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <wchar.h>
 #include <io.h>
 #include "render.h"
+#include "profiler.h"
+#include "atlas.h"
+#include "framebuffer.h"
+#include "glyph_cache.h"
+#include "log.h"
+
+#define DIRTY_AREA_LIMIT 2 // 脏区域总面积超过屏幕面积的 1 / DIRTY_AREA_LIMIT 时，直接整屏重绘更便宜
+#define PROFILER_OVERLAY_WIDTH 330
+#define PROFILER_OVERLAY_LINE_HEIGHT 15
+#define PROFILER_OVERLAY_GRAPH_HEIGHT 48
+#define PROFILER_OVERLAY_GRAPH_MS 33.3 // 帧耗时曲线的满刻度，单位：毫秒
+#define RENDER_GLYPH_MAX 512 // 单个字形的最大宽高，单位：像素
 
- // 在一个编译单元里定义纹理实例，其他文件只会使用 extern 声明。
-RenderTextures g_render_textures = { 0 };
+/**
+ * @brief 一个精灵：它所在的图像，以及它在图像中占据的矩形。从图集加载时所有精灵共用同一张图像。
+ */
+typedef struct RenderSprite {
+	IMAGE* image;
+	int x, y;
+	int width, height;
+} RenderSprite;
+
+/**
+ * @brief 用来存放图片，如果加载图片没成功，也不会崩溃。
+ */
+typedef struct RenderTextures {
+	IMAGE atlas; // 从图集加载时所有精灵共用的图像
+	IMAGE background_image; // 以下四张图像只在逐个加载 PNG 时使用
+	IMAGE player_image;
+	IMAGE enemy_image;
+	IMAGE bullet_image;
+	RenderSprite background;
+	RenderSprite player;
+	RenderSprite enemy;
+	RenderSprite bullet;
+	int background_ok;
+	int player_ok;
+	int enemy_ok;
+	int bullet_ok;
+} RenderTextures;
+
+static RenderTextures g_render_textures = { 0 };
+
+/**
+ * @brief 可增长的矩形数组，用于记录一帧中精灵占据的区域。
+ */
+typedef struct RectList {
+	RECT* rects;
+	size_t count;
+	size_t capacity;
+} RectList;
+
+/**
+ * @brief 缓存的一段 HUD 文字。只有文字或位置变化时才重新测量。
+ */
+typedef struct HudText {
+	int valid;
+	int changed; // 本帧是否发生了变化
+	int x, y;
+	int font_size;
+	int centered;
+	wchar_t text[64];
+	RECT rect; // 文字在屏幕上占据的区域
+} HudText;
+
+static inline int load_internal_texture(IMAGE* img, RenderSprite* sprite, int* flag, const wchar_t* path);
+
+static RenderMode g_render_mode = RENDER_MODE_DIRTY_RECTS;
+static int g_frame_valid = 0; // 屏幕上是否仍是上一帧游戏画面，为 0 时下一帧需要完整重绘
+static RectList g_sprite_rects = { 0 }; // 本帧绘制的精灵区域
+static RectList g_damage_rects = { 0 }; // 本帧从背景恢复的区域：上一帧的精灵区域与变化前的 HUD 文字区域
+static HudText g_hud_texts[RENDER_TEXT_SLOTS] = { 0 };
+static FramebufferSprites g_software_sprites = { 0 }; // RENDER_MODE_SOFTWARE 使用的精灵，第一次以这种方式绘制时生成
+static int g_software_sprites_ready = 0;
+static FramebufferImage g_software_target = { 0 }; // RENDER_MODE_SOFTWARE 下本帧的合成目标，即窗口的图像缓冲区
+static int g_frame_full = 0; // 本帧是否整屏重绘
+
+/**
+ * @brief 文字使用的字体，编号即字形缓存中的 font。
+ */
+typedef enum RenderFont {
+	RENDER_FONT_SONG,
+	RENDER_FONT_CONSOLAS,
+	RENDER_FONT_IMPACT,
+	RENDER_FONT_COUNT
+} RenderFont;
+
+static const wchar_t* g_render_font_faces[RENDER_FONT_COUNT] = { L"宋体", L"Consolas", L"Impact" };
+static GlyphCache g_glyph_cache = { 0 }; // 菜单、HUD 与叠加层共用，菜单与渲染线程不会同时绘制
+static IMAGE g_glyph_canvas; // 光栅化单个字符的画布
+static uint8_t g_glyph_coverage[RENDER_GLYPH_MAX * RENDER_GLYPH_MAX];
+
+void render_set_mode(const RenderMode mode) {
+	g_render_mode = mode;
+	g_frame_valid = 0;
+}
+
+void render_invalidate() {
+	g_frame_valid = 0;
+}
+
+static void rect_list_push(RectList* list, const RECT rect) {
+	if (list->count == list->capacity) {
+		const size_t new_capacity = list->capacity ? list->capacity * 2 : 256;
+		RECT* new_rects = (RECT*)realloc(list->rects, new_capacity * sizeof(RECT));
+		if (!new_rects) {
+			fprintf(stderr, "realloc() failed.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		list->rects = new_rects;
+		list->capacity = new_capacity;
+	}
+
+	list->rects[list->count++] = rect;
+}
+
+static int rect_list_intersects(const RectList* list, const RECT* rect) {
+	for (size_t i = 0; i < list->count; ++i) {
+		const RECT* other = &list->rects[i];
+		if (other->left < rect->right && rect->left < other->right && other->top < rect->bottom && rect->top < other->bottom) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @brief 用缓存的背景覆盖屏幕上的一块区域，区域会先被裁剪到屏幕范围内。
+ */
+static void render_restore_background(const RECT* rect, const int width, const int height) {
+	const int left = rect->left > 0 ? rect->left : 0;
+	const int top = rect->top > 0 ? rect->top : 0;
+	const int right = rect->right < width ? rect->right : width;
+	const int bottom = rect->bottom < height ? rect->bottom : height;
+	if (left >= right || top >= bottom) {
+		return;
+	}
+
+	if (g_render_textures.background_ok) {
+		const RenderSprite* background = &g_render_textures.background;
+		putimage(left, top, right - left, bottom - top, background->image, background->x + left, background->y + top);
+	}
+	else {
+		setfillcolor(RGB(5, 15, 40));
+		solidrectangle(left, top, right - 1, bottom - 1);
+	}
+}
+
+/**
+ * @brief 在 (x, y) 处绘制一个精灵。
+ */
+static void render_put_sprite(const RenderSprite* sprite, const int x, const int y) {
+	putimage(x, y, sprite->width, sprite->height, sprite->image, sprite->x, sprite->y);
+}
+
+/**
+ * @brief 窗口的图像缓冲区。
+ */
+static FramebufferImage render_window_target() {
+	const int width = getwidth();
+	return FramebufferImage{ (uint32_t*)GetImageBuffer(NULL), width, getheight(), width };
+}
 
 /**
- * @brief 获取数字难度对应的文字。
+ * @brief 字形缓存的光栅化函数：用 GDI 把单个字符以白色画在黑色画布上，取每个像素最亮的通道作为覆盖率。
+ *        只有缓存中还没有的字形才会调用到这里。
  */
-static const wchar_t* difficulty_to_text(const int difficulty) {
-	switch (difficulty) {
-	case 0:  return L"简单";
-	case 1:  return L"普通";
-	case 2:  return L"困难";
-	default: return L"未知";
+static bool render_rasterize_glyph(void* context, const int font, const int size, const uint32_t codepoint, GlyphBitmap* bitmap) {
+	(void)context;
+	if (font < 0 || font >= RENDER_FONT_COUNT || codepoint > WCHAR_MAX) {
+		return false;
 	}
+
+	const wchar_t text[2] = { (wchar_t)codepoint, L'\0' };
+	IMAGE* previous = GetWorkingImage();
+	SetWorkingImage(&g_glyph_canvas);
+	settextstyle(size, 0, g_render_font_faces[font]);
+	const int width = textwidth(text);
+	const int height = textheight(text);
+	if (width <= 0 || height <= 0 || width > RENDER_GLYPH_MAX || height > RENDER_GLYPH_MAX) {
+		SetWorkingImage(previous);
+		return false;
+	}
+
+	// Resize() 会重置画布的绘图状态，字体须重新设置。
+	Resize(&g_glyph_canvas, width, height);
+	settextstyle(size, 0, g_render_font_faces[font]);
+	setbkcolor(BLACK);
+	cleardevice();
+	setbkmode(TRANSPARENT);
+	settextcolor(WHITE);
+	outtextxy(0, 0, text);
+
+	const DWORD* pixels = GetImageBuffer(&g_glyph_canvas);
+	for (int i = 0; i < width * height; ++i) {
+		const uint8_t r = (uint8_t)(pixels[i] >> 16), g = (uint8_t)(pixels[i] >> 8), b = (uint8_t)pixels[i];
+		const uint8_t rg = r > g ? r : g;
+		g_glyph_coverage[i] = rg > b ? rg : b;
+	}
+	SetWorkingImage(previous);
+
+	bitmap->coverage = g_glyph_coverage;
+	bitmap->width = width;
+	bitmap->height = height;
+	bitmap->stride = width;
+	bitmap->advance = width;
+	return true;
+}
+
+/**
+ * @brief 取一段文字的排版，第一次使用时初始化字形缓存。
+ */
+static const GlyphLayout* render_text_layout(const RenderFont font, const int size, const COLORREF color, const wchar_t* text) {
+	if (!g_glyph_cache.glyphs) {
+		glyph_cache_init(&g_glyph_cache, render_rasterize_glyph, NULL);
+	}
+	const uint32_t rgb = (uint32_t)GetRValue(color) << 16 | (uint32_t)GetGValue(color) << 8 | GetBValue(color);
+	return glyph_cache_layout(&g_glyph_cache, font, size, rgb, text);
+}
+
+/**
+ * @brief 把文字绘制到窗口，(x, y) 是文字的左上角，与 outtextxy() 相同。
+ */
+static void render_text(const RenderFont font, const int size, const COLORREF color, const int x, const int y, const wchar_t* text) {
+	const GlyphLayout* layout = render_text_layout(font, size, color, text);
+	FramebufferImage target = render_window_target();
+	glyph_cache_draw(&g_glyph_cache, &target, layout, x, y);
+}
+
+/**
+ * @brief 以 center_x 为水平中心绘制文字。
+ */
+static void render_text_centered(const RenderFont font, const int size, const COLORREF color, const int center_x, const int y, const wchar_t* text) {
+	const GlyphLayout* layout = render_text_layout(font, size, color, text);
+	FramebufferImage target = render_window_target();
+	glyph_cache_draw(&g_glyph_cache, &target, layout, center_x - layout->width / 2, y);
 }
 
 /**
@@ -45,20 +271,92 @@ void window_create(const int width, const int height, const wchar_t* title) {
  * @brief 关闭 EasyX 窗口
  */
 void window_close() {
+	glyph_cache_free(&g_glyph_cache);
 	closegraph();
 }
 
 int render_load_texture(const wchar_t* background_path, const wchar_t* player_path, const wchar_t* enemy_path, const wchar_t* bullet_path) {
 
 	// 游戏内所有贴图的批量加载
-	int ok1 = load_internal_texture(&g_render_textures.background, &g_render_textures.background_ok, background_path);
-	int ok2 = load_internal_texture(&g_render_textures.player, &g_render_textures.player_ok, player_path);
-	int ok3 = load_internal_texture(&g_render_textures.enemy, &g_render_textures.enemy_ok, enemy_path);
-	int ok4 = load_internal_texture(&g_render_textures.bullet, &g_render_textures.bullet_ok, bullet_path);
+	int ok1 = load_internal_texture(&g_render_textures.background_image, &g_render_textures.background, &g_render_textures.background_ok, background_path);
+	int ok2 = load_internal_texture(&g_render_textures.player_image, &g_render_textures.player, &g_render_textures.player_ok, player_path);
+	int ok3 = load_internal_texture(&g_render_textures.enemy_image, &g_render_textures.enemy, &g_render_textures.enemy_ok, enemy_path);
+	int ok4 = load_internal_texture(&g_render_textures.bullet_image, &g_render_textures.bullet, &g_render_textures.bullet_ok, bullet_path);
 
 	return ok1 & ok2 & ok3 & ok4;
 }
 
+/**
+ * @brief 用图集中名为 name 的精灵填写 sprite。
+ */
+static int render_atlas_sprite(const Atlas* atlas, const char* name, RenderSprite* sprite) {
+	const AtlasSprite* entry = atlas_find(atlas, name);
+	if (entry == NULL) {
+		LOG_WARN("Sprite atlas has no sprite named %s.", name);
+		return 0;
+	}
+
+	sprite->image = &g_render_textures.atlas;
+	sprite->x = entry->x;
+	sprite->y = entry->y;
+	sprite->width = entry->width;
+	sprite->height = entry->height;
+	return 1;
+}
+
+int render_load_atlas(const wchar_t* atlas_path) {
+	const wchar_t* resolved = resolve_asset_path(atlas_path);
+	HANDLE file = CreateFileW(resolved, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		LOG_INFO("No sprite atlas found, loading PNG files instead.");
+		return 0;
+	}
+
+	LARGE_INTEGER size = { 0 };
+	HANDLE mapping = NULL;
+	const void* view = NULL;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+		mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping != NULL) {
+			view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		}
+	}
+
+	Atlas atlas;
+	RenderSprite background, player, enemy, bullet;
+	int ok = view != NULL && atlas_parse(&atlas, view, (size_t)size.QuadPart);
+	if (!ok) {
+		LOG_WARN("Sprite atlas is corrupt, loading PNG files instead.");
+	}
+	else {
+		ok = render_atlas_sprite(&atlas, "background", &background) & render_atlas_sprite(&atlas, "player", &player)
+			& render_atlas_sprite(&atlas, "enemy", &enemy) & render_atlas_sprite(&atlas, "bullet", &bullet);
+	}
+
+	// 图集的像素格式与 EasyX 的图像缓冲区相同，整块复制即可，复制完即可解除映射。
+	if (ok) {
+		g_render_textures.atlas.Resize(atlas.width, atlas.height);
+		memcpy(GetImageBuffer(&g_render_textures.atlas), atlas.pixels, sizeof(DWORD) * atlas.width * atlas.height);
+
+		g_render_textures.background = background;
+		g_render_textures.player = player;
+		g_render_textures.enemy = enemy;
+		g_render_textures.bullet = bullet;
+		g_render_textures.background_ok = g_render_textures.player_ok = g_render_textures.enemy_ok = g_render_textures.bullet_ok = 1;
+
+		LOG_INFO("Sprite atlas loaded: %d x %d, %zu sprites.", atlas.width, atlas.height, atlas.sprite_count);
+	}
+
+	if (view != NULL) {
+		UnmapViewOfFile(view);
+	}
+	if (mapping != NULL) {
+		CloseHandle(mapping);
+	}
+	CloseHandle(file);
+	return ok;
+}
+
 /**
  * @brief 构造一个矩形。
  */
@@ -89,79 +387,98 @@ static inline void menu_draw_button(const Button* button) {
 	if (button->hovered) {
 		setfillcolor(RGB(80, 160, 255));
 		setlinecolor(RGB(255, 255, 255));
-		settextcolor(RGB(255, 255, 255));
 	}
 	else {
 		setfillcolor(RGB(40, 80, 160));
 		setlinecolor(RGB(200, 200, 200));
-		settextcolor(RGB(230, 230, 230));
 	}
 
 	solidrectangle(button->rect.left, button->rect.top, button->rect.right, button->rect.bottom);
 	rectangle(button->rect.left, button->rect.top, button->rect.right, button->rect.bottom);
 
-	settextstyle(24, 0, L"宋体");
-	RECT textRect = button->rect;
-	drawtext(button->text, &textRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
+	// 文字在按钮中水平、垂直居中。
+	const COLORREF color = button->hovered ? RGB(255, 255, 255) : RGB(230, 230, 230);
+	const GlyphLayout* layout = render_text_layout(RENDER_FONT_SONG, 24, color, button->text);
+	FramebufferImage target = render_window_target();
+	glyph_cache_draw(&g_glyph_cache, &target, layout,
+		(button->rect.left + button->rect.right - layout->width) / 2, (button->rect.top + button->rect.bottom - layout->height) / 2);
 }
 
-static void menu_render_frame(const Button* buttons, const size_t button_count, const int width, const int height, const int high_score[3], const int difficulty) {
-	wchar_t line_easy[64];
-	wchar_t line_normal[64];
-	wchar_t line_hard[64];
+/**
+ * @brief 菜单事件循环：阻塞等待鼠标消息，只有某个按钮的悬停状态变化时才重绘，没有输入时不占用 CPU。
+ * @return 被点击的按钮的序号。
+ */
+static int menu_run(Button* buttons, const size_t button_count, const MenuDrawFunc draw, const MenuContext* context) {
+	render_invalidate();
+	draw(buttons, button_count, context);
 
+	while (true) {
+		ExMessage msg;
+		getmessage(&msg, EM_MOUSE);
+
+		if (msg.message == WM_MOUSEMOVE) {
+			int changed = 0;
+			for (size_t i = 0; i < button_count; ++i) {
+				const int hovered = menu_hit_test(&buttons[i], msg.x, msg.y);
+				changed |= hovered != buttons[i].hovered;
+				buttons[i].hovered = hovered;
+			}
+
+			if (changed) {
+				draw(buttons, button_count, context);
+			}
+		}
+		else if (msg.message == WM_LBUTTONDOWN) {
+			for (size_t i = 0; i < button_count; ++i) {
+				if (menu_hit_test(&buttons[i], msg.x, msg.y)) {
+					return (int)i;
+				}
+			}
+		}
+	}
+}
+
+static void menu_render_frame(const Button* buttons, const size_t button_count, const MenuContext* context) {
+	const int width = context->width;
+	const int height = context->height;
+	const int* high_score = context->high_score;
+	const int difficulty = context->difficulty;
 	BeginBatchDraw();
 
 	// 如果贴图没加载成功，则使用纯色背景。
 	if (g_render_textures.background_ok) {
-		putimage(0, 0, &g_render_textures.background);
+		render_put_sprite(&g_render_textures.background, 0, 0);
 	}
 	else {
 		setfillcolor(RGB(10, 20, 60));
 		solidrectangle(0, 0, width, height);
 	}
 
-	settextstyle(36, 0, L"宋体");
-	settextcolor(RGB(255, 255, 200));
-	const wchar_t* title = L"飞机大战";
-	outtextxy(width / 2 - textwidth(title) / 2, height / 4 - 40, title);
+	render_text_centered(RENDER_FONT_SONG, 36, RGB(255, 255, 200), width / 2, height / 4 - 40, L"飞机大战");
 
-	// 将「当前难度 + 三行最高分」移动到底部并居中显示
-	settextstyle(18, 0, L"宋体");
-	settextcolor(RGB(200, 200, 160));
+	// 将「当前难度 + 各难度最高分」移动到底部并居中显示
 	wchar_t diff_buf[64];
-	_snwprintf_s(diff_buf, _countof(diff_buf), L"当前难度：%ls", difficulty_to_text(difficulty));
+	_snwprintf_s(diff_buf, _countof(diff_buf), L"当前难度：%ls", render_difficulty_text(difficulty));
 
-	settextstyle(20, 0, L"宋体");
-	settextcolor(RGB(200, 200, 200));
-	_snwprintf_s(line_easy, _countof(line_easy), L"简单模式最高分：%d", high_score[0]);
-	_snwprintf_s(line_normal, _countof(line_normal), L"普通模式最高分：%d", high_score[1]);
-	_snwprintf_s(line_hard, _countof(line_hard), L"困难模式最高分：%d", high_score[2]);
-
-	// 计算底部起始 y，四行逐行向上排列并居中（水平以文本宽度居中）
-	const int footer_lines = 4;
+	// 计算底部起始 y，各行逐行向上排列并居中（水平以文本宽度居中）
+	const int footer_lines = DIFFICULTY_COUNT + 1;
 	const int footer_spacing = 28; // 行间距，可根据视觉调整
 	const int bottom_margin = 24; // 离窗口底部的外边距
 	const int start_y = height - bottom_margin - footer_spacing * (footer_lines - 1);
 
-	// 先绘制难度（使用 18 号字体），再绘制三行分数（20 号字体）
-	settextstyle(18, 0, L"宋体");
-	settextcolor(RGB(200, 200, 160));
-	outtextxy(width / 2 - textwidth(diff_buf) / 2, start_y, diff_buf);
-
-	settextstyle(20, 0, L"宋体");
-	settextcolor(RGB(200, 200, 200));
-	outtextxy(width / 2 - textwidth(line_easy) / 2, start_y + footer_spacing * 1, line_easy);
-	outtextxy(width / 2 - textwidth(line_normal) / 2, start_y + footer_spacing * 2, line_normal);
-	outtextxy(width / 2 - textwidth(line_hard) / 2, start_y + footer_spacing * 3, line_hard);
+	// 先绘制难度（使用 18 号字体），再逐行绘制各难度的分数（20 号字体）
+	render_text_centered(RENDER_FONT_SONG, 18, RGB(200, 200, 160), width / 2, start_y, diff_buf);
+	for (int i = 0; i < DIFFICULTY_COUNT; ++i) {
+		wchar_t line[64];
+		_snwprintf_s(line, _countof(line), _TRUNCATE, L"%ls模式最高分：%d", difficulty_names[i], high_score[i]);
+		render_text_centered(RENDER_FONT_SONG, 20, RGB(200, 200, 200), width / 2, start_y + footer_spacing * (i + 1), line);
+	}
 
 	for (size_t i = 0; i < button_count; ++i) {
 		menu_draw_button(&buttons[i]);
 	}
 
-	settextstyle(16, 0, L"宋体");
-	settextcolor(RGB(180, 180, 180));
-	outtextxy(10, 36, L"鼠标悬停选择，左键点击确认");
+	render_text(RENDER_FONT_SONG, 16, RGB(180, 180, 180), 10, 36, L"鼠标悬停选择，左键点击确认");
 
 	FlushBatchDraw();
 }
@@ -170,7 +487,7 @@ static void menu_render_frame(const Button* buttons, const size_t button_count,
  * @brief 渲染主菜单的主要接口。
  * @returns 返回被按下的按钮的 id：0 = 开始游戏，1 = 选项，2 = 退出
  */
-int render_draw_main_menu(const int width, const int height, const int high_score[3], const int difficulty, const int fps) {
+int render_draw_main_menu(const int width, const int height, const int high_score[DIFFICULTY_COUNT], const int difficulty) {
 	const wchar_t* labels[] = { L"开始游戏", L"选择难度", L"退出" };
 	const size_t button_count = _countof(labels);
 	const int button_width = 240;
@@ -179,152 +496,320 @@ int render_draw_main_menu(const int width, const int height, const int high_scor
 	const int center_x = (width - button_width) / 2;
 	const int center_y = height / 2 - (int)((button_height * button_count + spacing * (button_count - 1)) / 2);
 
-	Button buttons[3] = { 0 };
+	Button buttons[_countof(labels)] = { 0 };
 	for (size_t i = 0; i < button_count; ++i) {
 		menu_copy_label(buttons[i].text, _countof(buttons[i].text), labels[i]);
 		buttons[i].rect = menu_make_rect(center_x, center_y + (int)i * (button_height + spacing), button_width, button_height);
 		buttons[i].hovered = 0;
 	}
 
-	while (true) {
-		ExMessage msg;
-		while (peekmessage(&msg, EM_MOUSE, TRUE)) {
-			if (msg.message == WM_MOUSEMOVE) {
-				for (size_t i = 0; i < button_count; ++i) {
-					buttons[i].hovered = menu_hit_test(&buttons[i], msg.x, msg.y);
-				}
-			}
-			else if (msg.message == WM_LBUTTONDOWN) {
-				for (size_t i = 0; i < button_count; ++i) {
-					if (menu_hit_test(&buttons[i], msg.x, msg.y)) {
-						return (int)i;
-					}
-				}
-			}
-		}
+	const MenuContext context = { width, height, high_score, difficulty, NULL };
+	return menu_run(buttons, button_count, menu_render_frame, &context);
+}
+
+static void difficulty_menu_render_frame(const Button* buttons, const size_t button_count, const MenuContext* context) {
+	const int width = context->width;
+	const int height = context->height;
+	const int difficulty = context->difficulty;
 
-		menu_render_frame(buttons, button_count, width, height, high_score, difficulty);
-		Sleep(1000 / fps);
+	BeginBatchDraw();
+	if (g_render_textures.background_ok) {
+		render_put_sprite(&g_render_textures.background, 0, 0);
 	}
+	else {
+		setfillcolor(RGB(10, 20, 60));
+		solidrectangle(0, 0, width, height);
+	}
+
+	render_text_centered(RENDER_FONT_SONG, 36, RGB(255, 255, 200), width / 2, height / 4 - 40, L"选择难度");
+
+	wchar_t current_buf[64];
+	_snwprintf_s(current_buf, _countof(current_buf), L"当前：%ls", render_difficulty_text(difficulty));
+	render_text_centered(RENDER_FONT_SONG, 18, RGB(255, 255, 200), width / 2, height / 4 - 8, current_buf);
+
+	for (size_t i = 0; i < button_count; ++i) {
+		menu_draw_button(&buttons[i]);
+	}
+
+	FlushBatchDraw();
 }
 
 /**
  * @brief 渲染难度选择界面。
  * @return 返回选择的难度。
  */
-int render_draw_difficulty_menu(const int width, const int height, const int difficulty, const int fps) {
-	const wchar_t* labels[] = { L"简单", L"普通", L"困难" };
-	const size_t button_count = _countof(labels);
+int render_draw_difficulty_menu(const int width, const int height, const int difficulty) {
+	const wchar_t* const* labels = difficulty_names;
+	const size_t button_count = DIFFICULTY_COUNT;
 	const int button_width = 220;
 	const int button_height = 56;
 	const int spacing = 12;
 	const int center_x = (width - button_width) / 2;
 	const int center_y = height / 2 - (int)((button_height * button_count + spacing * (button_count - 1)) / 2);
 
-	Button buttons[3] = { 0 };
+	Button buttons[DIFFICULTY_COUNT] = { 0 };
 	for (size_t i = 0; i < button_count; ++i) {
 		menu_copy_label(buttons[i].text, _countof(buttons[i].text), labels[i]);
 		buttons[i].rect = menu_make_rect(center_x, center_y + (int)i * (button_height + spacing), button_width, button_height);
 		buttons[i].hovered = 0;
 	}
 
-	while (true) {
-		ExMessage msg;
-		while (peekmessage(&msg, EM_MOUSE, TRUE)) {
-			if (msg.message == WM_MOUSEMOVE) {
-				for (size_t i = 0; i < button_count; ++i) {
-					buttons[i].hovered = menu_hit_test(&buttons[i], msg.x, msg.y);
-				}
-			}
-			else if (msg.message == WM_LBUTTONDOWN) {
-				for (size_t i = 0; i < button_count; ++i) {
-					if (menu_hit_test(&buttons[i], msg.x, msg.y)) {
-						return (int)i;
-					}
-				}
-			}
-		}
+	const MenuContext context = { width, height, NULL, difficulty, NULL };
+	return menu_run(buttons, button_count, difficulty_menu_render_frame, &context);
+}
 
-		BeginBatchDraw();
-		if (g_render_textures.background_ok) {
-			putimage(0, 0, &g_render_textures.background);
-		}
-		else {
-			setfillcolor(RGB(10, 20, 60));
-			solidrectangle(0, 0, width, height);
-		}
+/**
+ * @brief 在右上角绘制性能分析叠加层：各阶段在滚动窗口内的耗时统计，以及最近若干帧的帧耗时曲线。
+ *        叠加层占据的区域记入本帧的精灵区域，下一帧会从背景中恢复。
+ */
+static void render_draw_profiler_overlay(const int width) {
+	const int left = width - PROFILER_OVERLAY_WIDTH - 8;
+	const int top = 8;
+	const int graph_top = top + PROFILER_OVERLAY_LINE_HEIGHT * (PROFILE_PHASE_COUNT + 1) + 6;
+	const RECT rect = { left, top, left + PROFILER_OVERLAY_WIDTH, graph_top + PROFILER_OVERLAY_GRAPH_HEIGHT + 4 };
+
+	setfillcolor(RGB(0, 0, 0));
+	solidrectangle(rect.left, rect.top, rect.right - 1, rect.bottom - 1);
+	rect_list_push(&g_sprite_rects, rect);
+
+	const COLORREF color = RGB(200, 200, 200);
+	render_text(RENDER_FONT_CONSOLAS, PROFILER_OVERLAY_LINE_HEIGHT, color, left + 4, top, L"phase (ms)         last   avg   p99   max");
+
+	wchar_t text[96];
+	for (int i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+		const ProfilerStats stats = profiler_stats((ProfilerPhase)i);
+		_snwprintf_s(text, _countof(text), _TRUNCATE, L"%-17hs %5.2f %5.2f %5.2f %5.2f",
+			profiler_phase_name((ProfilerPhase)i), stats.last, stats.mean, stats.p99, stats.max);
+		render_text(RENDER_FONT_CONSOLAS, PROFILER_OVERLAY_LINE_HEIGHT, color, left + 4, top + PROFILER_OVERLAY_LINE_HEIGHT * (i + 1), text);
+	}
+
+	// 帧耗时曲线，每帧一个像素宽，绿线表示 60 FPS 的预算。
+	const int graph_bottom = graph_top + PROFILER_OVERLAY_GRAPH_HEIGHT;
+	const int budget_y = graph_bottom - (int)(PROFILER_OVERLAY_GRAPH_HEIGHT * (1000.0 / 60) / PROFILER_OVERLAY_GRAPH_MS);
+	const int samples = PROFILER_OVERLAY_WIDTH - 8 < PROFILER_WINDOW ? PROFILER_OVERLAY_WIDTH - 8 : PROFILER_WINDOW;
+	setlinecolor(RGB(255, 160, 60));
+	for (int age = 0; age < samples; ++age) {
+		const double ms = profiler_history(PROFILE_FRAME, (size_t)age);
+		const double scaled = ms < PROFILER_OVERLAY_GRAPH_MS ? ms / PROFILER_OVERLAY_GRAPH_MS : 1.0;
+		const int x = rect.right - 4 - age;
+		line(x, graph_bottom, x, graph_bottom - (int)(PROFILER_OVERLAY_GRAPH_HEIGHT * scaled));
+	}
+	setlinecolor(RGB(80, 220, 80));
+	line(rect.left + 4, budget_y, rect.right - 4, budget_y);
+}
 
-		settextstyle(36, 0, L"宋体");
-		settextcolor(RGB(255, 255, 200));
-		const wchar_t* title = L"选择难度";
-		outtextxy(width / 2 - textwidth(title) / 2, height / 4 - 40, title);
+/**
+ * @brief 取精灵在 EasyX 图像缓冲区中的像素，不复制。
+ */
+static FramebufferImage render_sprite_pixels(const RenderSprite* sprite) {
+	const FramebufferImage image = { (uint32_t*)GetImageBuffer(sprite->image), sprite->image->getwidth(), sprite->image->getheight(), sprite->image->getwidth() };
+	return framebuffer_view(&image, sprite->x, sprite->y, sprite->width, sprite->height);
+}
 
-		settextstyle(18, 0, L"宋体");
-		wchar_t current_buf[64];
-		_snwprintf_s(current_buf, _countof(current_buf), L"当前：%ls", difficulty_to_text(difficulty));
-		outtextxy(width / 2 - textwidth(current_buf) / 2, height / 4 - 8, current_buf);
+/**
+ * @brief 生成 RENDER_MODE_SOFTWARE 使用的精灵：背景不透明，直接引用；其余精灵复制一份并预乘 alpha。
+ */
+static void render_prepare_software_sprites() {
+	if (g_software_sprites_ready) {
+		return;
+	}
 
-		for (size_t i = 0; i < button_count; ++i) {
-			menu_draw_button(&buttons[i]);
+	if (g_render_textures.background_ok) {
+		g_software_sprites.background = render_sprite_pixels(&g_render_textures.background);
+	}
+	if (g_render_textures.player_ok) {
+		const FramebufferImage player = render_sprite_pixels(&g_render_textures.player);
+		framebuffer_premultiply(&g_software_sprites.player, &player);
+	}
+	if (g_render_textures.enemy_ok) {
+		const FramebufferImage enemy = render_sprite_pixels(&g_render_textures.enemy);
+		framebuffer_premultiply(&g_software_sprites.enemy, &enemy);
+	}
+	if (g_render_textures.bullet_ok) {
+		const FramebufferImage bullet = render_sprite_pixels(&g_render_textures.bullet);
+		framebuffer_premultiply(&g_software_sprites.bullet, &bullet);
+	}
+	g_software_sprites_ready = 1;
+}
+
+/**
+ * @brief 开始一帧。RENDER_MODE_DIRTY_RECTS 下不再整屏绘制背景：上一帧精灵占据的区域从缓存的背景中恢复，脏区域过多时退回整屏重绘。
+ *        RENDER_MODE_SOFTWARE 下背景直接复制到窗口的图像缓冲区，之后的精灵也合成到这里。
+ */
+static void easyx_begin_frame() {
+	const int width = getwidth();
+	const int height = getheight();
+
+	BeginBatchDraw();
+
+	if (g_render_mode == RENDER_MODE_SOFTWARE) {
+		render_prepare_software_sprites();
+		g_software_target = render_window_target();
+
+		const FramebufferImage* background = &g_software_sprites.background;
+		if (!background->pixels || background->width < width || background->height < height) {
+			framebuffer_fill(&g_software_target, FRAMEBUFFER_BACKGROUND_COLOR);
 		}
+		if (background->pixels) {
+			framebuffer_copy(&g_software_target, background, 0, 0);
+		}
+		g_sprite_rects.count = g_damage_rects.count = 0;
+		g_frame_full = 1;
+		return;
+	}
+
+	// 上一帧绘制的精灵区域就是本帧需要恢复的区域。
+	const RectList last_sprites = g_sprite_rects;
+	g_sprite_rects = g_damage_rects;
+	g_damage_rects = last_sprites;
+	g_sprite_rects.count = 0;
 
-		FlushBatchDraw();
-		Sleep(1000 / fps);
+	long long damaged_area = 0;
+	for (size_t i = 0; i < g_damage_rects.count; ++i) {
+		const RECT* rect = &g_damage_rects.rects[i];
+		damaged_area += (long long)(rect->right - rect->left) * (rect->bottom - rect->top);
 	}
 
-	return difficulty;
+	g_frame_full = g_render_mode == RENDER_MODE_FULL || !g_frame_valid || damaged_area * DIRTY_AREA_LIMIT > (long long)width * height;
+	if (g_frame_full) {
+		const RECT screen = { 0, 0, width, height };
+		render_restore_background(&screen, width, height);
+		g_damage_rects.count = 0;
+	}
+	else {
+		for (size_t i = 0; i < g_damage_rects.count; ++i) {
+			render_restore_background(&g_damage_rects.rects[i], width, height);
+		}
+	}
 }
 
 /**
- * @brief 渲染游戏画面的主要接口。
+ * @brief 文字或位置变化时重新测量一段 HUD 文字，变化前的文字区域会立即恢复为背景并记为脏区域。
+ *        这一步在绘制精灵之前进行，不会擦掉本帧的精灵。文字本身在 easyx_present() 中绘制。
  */
-void render_draw_current_frame(const GameplayVisualState* state) {
-	if (state == NULL) {
+static void easyx_draw_text(const int slot, const int x, const int y, const int font_size, const bool centered, const wchar_t* text) {
+	if (slot < 0 || slot >= RENDER_TEXT_SLOTS) {
 		return;
 	}
 
-	BeginBatchDraw();
+	HudText* hud = &g_hud_texts[slot];
+	if (hud->valid && hud->x == x && hud->y == y && hud->font_size == font_size && hud->centered == (int)centered && !wcscmp(hud->text, text)) {
+		hud->changed = 0;
+		return;
+	}
 
-	if (g_render_textures.background_ok) {
-		putimage(0, 0, &g_render_textures.background);
+	if (hud->valid && g_render_mode != RENDER_MODE_SOFTWARE) {
+		render_restore_background(&hud->rect, getwidth(), getheight());
+		rect_list_push(&g_damage_rects, hud->rect);
 	}
-	else {
-		setfillcolor(RGB(5, 15, 40));
-		solidrectangle(0, 0, state->width, state->height);
+
+	wcsncpy_s(hud->text, text, _TRUNCATE);
+	const GlyphLayout* layout = render_text_layout(RENDER_FONT_SONG, font_size, RGB(255, 255, 255), hud->text);
+	const int left = centered ? x - layout->width / 2 : x;
+	hud->rect = RECT{ left, y, left + layout->width, y + layout->height };
+	hud->x = x;
+	hud->y = y;
+	hud->font_size = font_size;
+	hud->centered = centered;
+	hud->valid = 1;
+	hud->changed = 1;
+}
+
+/**
+ * @brief 绘制一批精灵，并记录它们占据的区域，供下一帧恢复背景。RENDER_MODE_SOFTWARE 下按 alpha 混合。
+ */
+static void easyx_draw_sprites(const RenderSpriteId sprite, const int* xs, const int* ys, const size_t count) {
+	const RenderSprite* image = NULL;
+	const FramebufferImage* software = NULL;
+	switch (sprite) {
+	case RENDER_SPRITE_PLAYER:
+		image = g_render_textures.player_ok ? &g_render_textures.player : NULL;
+		software = &g_software_sprites.player;
+		break;
+	case RENDER_SPRITE_ENEMY:
+		image = g_render_textures.enemy_ok ? &g_render_textures.enemy : NULL;
+		software = &g_software_sprites.enemy;
+		break;
+	default:
+		image = g_render_textures.bullet_ok ? &g_render_textures.bullet : NULL;
+		software = &g_software_sprites.bullet;
+		break;
+	}
+	if (image == NULL) {
+		return;
 	}
 
-	if (g_render_textures.enemy_ok && state->enemy_list) {
-		for (Node* enemy_node = state->enemy_list->head->next; enemy_node; enemy_node = enemy_node->next) {
-			const Object* enemy = (Object*)enemy_node->data;
-			putimage(enemy->x, enemy->y, &g_render_textures.enemy);
+	if (g_render_mode == RENDER_MODE_SOFTWARE) {
+		for (size_t i = 0; i < count; ++i) {
+			framebuffer_blend(&g_software_target, software, xs[i], ys[i]);
 		}
+		return;
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		render_put_sprite(image, xs[i], ys[i]);
+		rect_list_push(&g_sprite_rects, RECT{ xs[i], ys[i], xs[i] + image->width, ys[i] + image->height });
 	}
+}
 
-	if (g_render_textures.bullet_ok && state->bullet_list) {
-		for (Node* bullet_node = state->bullet_list->head->next; bullet_node; bullet_node = bullet_node->next) {
-			const Object* bullet = (Object*)bullet_node->data;
-			putimage(bullet->x, bullet->y, &g_render_textures.bullet);
+/**
+ * @brief 绘制 HUD 文字与性能分析叠加层，并提交这一帧。HUD 文字只在整屏重绘、发生变化或被恢复的区域与精灵覆盖时重绘。
+ */
+static void easyx_present() {
+	for (int i = 0; i < RENDER_TEXT_SLOTS; ++i) {
+		const HudText* hud = &g_hud_texts[i];
+		if (hud->valid && (g_frame_full || hud->changed || rect_list_intersects(&g_damage_rects, &hud->rect) || rect_list_intersects(&g_sprite_rects, &hud->rect))) {
+			render_text(RENDER_FONT_SONG, hud->font_size, RGB(255, 255, 255), hud->rect.left, hud->rect.top, hud->text);
 		}
 	}
 
-	if (g_render_textures.player_ok && state->player) {
-		putimage(state->player->x, state->player->y, &g_render_textures.player);
+	if (profiler_overlay_visible()) {
+		render_draw_profiler_overlay(getwidth());
+	}
+
+	// RENDER_MODE_SOFTWARE 不记录精灵区域，切回其他渲染方式时须完整重绘。
+	g_frame_valid = g_render_mode != RENDER_MODE_SOFTWARE;
+
+	FlushBatchDraw();
+}
+
+static bool easyx_open(const int width, const int height, const wchar_t* title) {
+	window_create(width, height, title);
+	return true;
+}
+
+/**
+ * @brief 优先加载图集，图集不存在或损坏时退回逐个加载 PNG。
+ */
+static bool easyx_load_textures(const wchar_t* atlas_path) {
+	if (render_load_atlas(atlas_path)) {
+		return true;
 	}
+	return render_load_texture(L"image\\background.png", L"image\\player.png", L"image\\enemy.png", L"image\\bullet.png") != 0;
+}
 
-	settextstyle(22, 0, L"宋体");
-	settextcolor(RGB(255, 255, 255));
-	wchar_t score_text[64];
-	_snwprintf_s(score_text, _countof(score_text), L"SCORE %d", state->score);
-	outtextxy(state->width / 2 - textwidth(score_text) / 2, state->height - 32, score_text);
+const RenderBackend render_backend_easyx = {
+	"easyx",
+	easyx_open,
+	window_close,
+	easyx_load_textures,
+	easyx_begin_frame,
+	easyx_draw_sprites,
+	easyx_draw_text,
+	easyx_present
+};
+
+static void pause_menu_render_frame(const Button* buttons, const size_t button_count, const MenuContext* context) {
+	const int width = context->width;
+	const int height = context->height;
+
+	BeginBatchDraw();
 
-	settextstyle(18, 0, L"宋体");
-	wchar_t diff_text[64];
-	_snwprintf_s(diff_text, _countof(diff_text), L"难度：%ls", difficulty_to_text(state->difficulty));
-	outtextxy(12, 12, diff_text);
+	render_text_centered(RENDER_FONT_SONG, 48, RGB(255, 255, 255), width / 2, height / 4 - 60, L"游戏已暂停");
 
-	wchar_t hp_text[64];
-	_snwprintf_s(hp_text, _countof(hp_text), L"HP：%d / %d", state->hp, state->starting_hp > 0 ? state->starting_hp : 1);
-	outtextxy(12, 36, hp_text);
+	for (size_t i = 0; i < button_count; ++i) {
+		menu_draw_button(&buttons[i]);
+	}
 
 	FlushBatchDraw();
 }
@@ -333,7 +818,7 @@ void render_draw_current_frame(const GameplayVisualState* state) {
  * @brief 渲染暂停界面。
  * @return 0 = 返回游戏，1 = 重新开始游戏，2 = 返回主菜单，3 = 退出游戏。
  */
-int render_draw_pause_menu(const int width, const int height, const int fps) {
+int render_draw_pause_menu(const int width, const int height) {
 	const wchar_t* labels[] = { L"返回游戏", L"重新开始游戏", L"返回主菜单", L"退出游戏" };
 	const size_t button_count = _countof(labels);
 	const int button_width = 320;
@@ -342,56 +827,52 @@ int render_draw_pause_menu(const int width, const int height, const int fps) {
 	const int center_x = (width - button_width) / 2;
 	const int center_y = height / 2 - (int)((button_height * button_count + spacing * (button_count - 1)) / 2);
 
-	Button buttons[4] = { 0 };
+	Button buttons[_countof(labels)] = { 0 };
 	for (size_t i = 0; i < button_count; ++i) {
 		menu_copy_label(buttons[i].text, _countof(buttons[i].text), labels[i]);
 		buttons[i].rect = menu_make_rect(center_x, center_y + (int)i * (button_height + spacing), button_width, button_height);
 		buttons[i].hovered = 0;
 	}
 
-	while (true) {
-		ExMessage msg;
-		while (peekmessage(&msg, EM_MOUSE, TRUE)) {
-			if (msg.message == WM_MOUSEMOVE) {
-				for (size_t i = 0; i < button_count; ++i) {
-					buttons[i].hovered = menu_hit_test(&buttons[i], msg.x, msg.y);
-				}
-			}
-			else if (msg.message == WM_LBUTTONDOWN) {
-				for (size_t i = 0; i < button_count; ++i) {
-					if (menu_hit_test(&buttons[i], msg.x, msg.y)) {
-						return (int)i;
-					}
-				}
-			}
-			else if (msg.message == WM_KEYDOWN && msg.vkcode == VK_ESCAPE) {
-				return 0;
-			}
-		}
+	const MenuContext context = { width, height, NULL, 0, NULL };
+	return menu_run(buttons, button_count, pause_menu_render_frame, &context);
+}
 
-		BeginBatchDraw();
+static void wasted_page_render_frame(const Button* buttons, const size_t button_count, const MenuContext* context) {
+	const GameplayVisualState* state = context->state;
+	const int* high_score = context->high_score;
 
-		settextstyle(48, 0, L"宋体");
-		settextcolor(RGB(255, 255, 255));
-		const wchar_t* title = L"游戏已暂停";
-		outtextxy(width / 2 - textwidth(title) / 2, height / 4 - 60, title);
+	BeginBatchDraw();
+	setfillcolor(RGB(60, 60, 60));
+	solidrectangle(0, 0, state->width, state->height);
 
-		for (size_t i = 0; i < button_count; ++i) {
-			menu_draw_button(&buttons[i]);
-		}
 
-		FlushBatchDraw();
-		Sleep(1000 / fps);
+	wchar_t score_buf[128];
+	_snwprintf_s(score_buf, _countof(score_buf), L"本次分数：%d", state->score);
+	render_text_centered(RENDER_FONT_SONG, 24, RGB(220, 220, 220), state->width / 2, 12, score_buf);
+
+	wchar_t high_buf[128];
+	_snwprintf_s(high_buf, _countof(high_buf), L"最高分（%ls）：%d", render_difficulty_text(state->difficulty), high_score[state->difficulty]);
+	render_text_centered(RENDER_FONT_SONG, 18, RGB(200, 200, 200), state->width / 2, 12 + 30, high_buf);
+
+	// 主标题 WASTED 保持在中间偏上显示
+	render_text_centered(RENDER_FONT_IMPACT, 72, RGB(220, 220, 220), state->width / 2, state->height / 2 - 160, L"WASTED");
+
+	const wchar_t* reason = state->death_reason != NULL ? state->death_reason : L"";
+	render_text_centered(RENDER_FONT_SONG, 28, RGB(220, 220, 220), state->width / 2, state->height / 2 - 60, reason);
+
+	for (size_t i = 0; i < button_count; ++i) {
+		menu_draw_button(&buttons[i]);
 	}
 
-	return 0;
+	FlushBatchDraw();
 }
 
 /**
  * @brief 渲染 WASTED 页面。
  * @return 0 = 重新开始，1 = 返回主菜单，2 = 退出游戏。
  */
-int render_draw_wasted_page(const GameplayVisualState* state, const int high_score[3], const int fps) {
+int render_draw_wasted_page(const GameplayVisualState* state, const int high_score[DIFFICULTY_COUNT]) {
 	if (state == NULL) {
 		return 2;
 	}
@@ -404,67 +885,15 @@ int render_draw_wasted_page(const GameplayVisualState* state, const int high_sco
 	const int center_x = (state->width - button_width) / 2;
 	const int center_y = state->height / 2 + 40;
 
-	Button buttons[3] = { 0 };
+	Button buttons[_countof(labels)] = { 0 };
 	for (size_t i = 0; i < button_count; ++i) {
 		menu_copy_label(buttons[i].text, _countof(buttons[i].text), labels[i]);
 		buttons[i].rect = menu_make_rect(center_x, center_y + (int)i * (button_height + spacing), button_width, button_height);
 		buttons[i].hovered = 0;
 	}
 
-	while (true) {
-		ExMessage msg;
-		while (peekmessage(&msg, EM_MOUSE, TRUE)) {
-			if (msg.message == WM_MOUSEMOVE) {
-				for (size_t i = 0; i < button_count; ++i) {
-					buttons[i].hovered = menu_hit_test(&buttons[i], msg.x, msg.y);
-				}
-			}
-			else if (msg.message == WM_LBUTTONDOWN) {
-				for (size_t i = 0; i < button_count; ++i) {
-					if (menu_hit_test(&buttons[i], msg.x, msg.y)) {
-						return (int)i;
-					}
-				}
-			}
-		}
-
-		BeginBatchDraw();
-		setfillcolor(RGB(60, 60, 60));
-		solidrectangle(0, 0, state->width, state->height);
-
-
-		wchar_t score_buf[128];
-		_snwprintf_s(score_buf, _countof(score_buf), L"本次分数：%d", state->score);
-		settextstyle(24, 0, L"宋体");
-		settextcolor(RGB(220, 220, 220));
-		outtextxy(state->width / 2 - textwidth(score_buf) / 2, 12, score_buf);
-
-		wchar_t high_buf[128];
-		_snwprintf_s(high_buf, _countof(high_buf), L"最高分（%ls）：%d", difficulty_to_text(state->difficulty), high_score[state->difficulty]);
-		settextstyle(18, 0, L"宋体");
-		settextcolor(RGB(200, 200, 200));
-		outtextxy(state->width / 2 - textwidth(high_buf) / 2, 12 + 30, high_buf);
-
-		// 主标题 WASTED 保持在中间偏上显示
-		settextstyle(72, 0, L"Impact");
-		settextcolor(RGB(220, 220, 220));
-		outtextxy(state->width / 2 - textwidth(L"WASTED") / 2, state->height / 2 - 160, L"WASTED");
-
-		settextstyle(28, 0, L"宋体");
-		const wchar_t* reason = state->death_reason != NULL ? state->death_reason : L"";
-		outtextxy(state->width / 2 - textwidth(reason) / 2, state->height / 2 - 60, reason);
-
-		settextstyle(24, 0, L"宋体");
-
-		for (size_t i = 0; i < button_count; ++i) {
-			menu_draw_button(&buttons[i]);
-		}
-
-		FlushBatchDraw();
-		Sleep(1000 / fps);
-	}
-
-	return 1;
+	const MenuContext context = { state->width, state->height, high_score, state->difficulty, state };
+	return menu_run(buttons, button_count, wasted_page_render_frame, &context);
 }
 
 const wchar_t* resolve_asset_path(const wchar_t* relative_path) {
@@ -511,13 +940,19 @@ const wchar_t* resolve_asset_path(const wchar_t* relative_path) {
 	return resolved;
 }
 
-static inline int load_internal_texture(IMAGE* img, int* flag, const wchar_t* path) {
+static inline int load_internal_texture(IMAGE* img, RenderSprite* sprite, int* flag, const wchar_t* path) {
 	const wchar_t* resolved = resolve_asset_path(path);
 	int ok = (resolved[0] != L'\0' && loadimage(img, resolved) == 0);
 
 	if (flag != NULL) {
 		*flag = ok;
 	}
+	if (ok && sprite != NULL) {
+		sprite->image = img;
+		sprite->x = sprite->y = 0;
+		sprite->width = img->getwidth();
+		sprite->height = img->getheight();
+	}
 
 	if (!ok) {
 		wchar_t buffer[512];
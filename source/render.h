@@ -8,12 +8,10 @@
 
 #pragma once
 #include <windows.h>
-#include <graphics.h>
 #include <stddef.h>
 #include <wchar.h>
-#include <io.h>
-#include "list.h"
-#include "object.h"
+#include "render_backend.h"
+#include "difficulty.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,53 +26,67 @@ extern "C" {
 		int hovered;
 	} Button;
 
-	typedef struct GameplayVisualState {
+	/**
+	 * @brief 菜单界面绘制时需要的数据，各个界面只使用其中的一部分。
+	 */
+	typedef struct MenuContext {
 		int width;
 		int height;
-		int score;
-		const wchar_t* death_reason;
-		const Object* player;
-		const List* enemy_list;
-		const List* bullet_list;
+		const int* high_score;
 		int difficulty;
-		int hp;
-		int starting_hp;
-	} GameplayVisualState;
+		const GameplayVisualState* state;
+	} MenuContext;
+
+	/**
+	 * @brief 绘制一帧菜单界面的函数。
+	 */
+	typedef void (*MenuDrawFunc)(const Button* buttons, const size_t button_count, const MenuContext* context);
 
 	/**
-	 * @brief 用来存放图片，如果加载图片没成功，也不会崩溃。
+	 * @brief 游戏画面的渲染方式。
 	 */
-	typedef struct RenderTextures {
-		IMAGE background;
-		IMAGE player;
-		IMAGE enemy;
-		IMAGE bullet;
-		int background_ok;
-		int player_ok;
-		int enemy_ok;
-		int bullet_ok;
-	} RenderTextures;
-
-	extern RenderTextures g_render_textures;
+	typedef enum RenderMode {
+		RENDER_MODE_FULL, // 每帧重绘整张背景、所有精灵与 HUD 文字
+		RENDER_MODE_DIRTY_RECTS, // 只用缓存的背景恢复上一帧精灵占据的区域，HUD 文字只在数值变化或被覆盖时重绘
+		RENDER_MODE_SOFTWARE // 背景与精灵在 CPU 上合成到窗口的图像缓冲区（见 framebuffer.h），精灵按 alpha 混合，整帧只提交一次
+	} RenderMode;
 
 	/**
-	 * @brief 获取数字难度对应的文字。
+	 * @brief EasyX 渲染后端，游戏画面的绘制方式由 render_set_mode() 选择。菜单界面只有 EasyX 实现，直接调用下面的函数。
 	 */
-	static const wchar_t* difficulty_to_text(const int difficulty);
+	extern const RenderBackend render_backend_easyx;
 
 	// 分别负责创建窗口，关闭窗口
 	void window_create(const int width, const int height, const wchar_t* title);
 	void window_close();
 
+	/**
+	 * @brief 选择游戏画面的渲染方式，默认为 RENDER_MODE_DIRTY_RECTS。
+	 */
+	void render_set_mode(const RenderMode mode);
+
+	/**
+	 * @brief 通知渲染器屏幕内容已被其他界面覆盖，下一帧游戏画面需要完整重绘。各个菜单界面会自动调用。
+	 */
+	void render_invalidate();
+
 	// 加载资源
 	int render_load_texture(const wchar_t* game_background_path, const wchar_t* player_path, const wchar_t* enemy_path, const wchar_t* bullet_path);
 
+	/**
+	 * @brief 从 bench/atlas_pack.cpp 生成的图集加载所有精灵：只查找一次路径，把文件映射到内存，校验索引后把像素整块复制进一张图像，
+	 *        各精灵取其中的子矩形，没有 PNG 解码。图集须包含名为 background、player、enemy、bullet 的精灵。
+	 * @return 图集不存在、损坏或缺少精灵时返回 0，不弹出对话框，调用者可以退回 render_load_texture()。
+	 */
+	int render_load_atlas(const wchar_t* atlas_path);
+
 	// 绘制菜单有关函数
 	static inline RECT menu_make_rect(const int x, const int y, const int w, const int h);
 	static inline int menu_hit_test(const Button* item, const int x, const int y);
 	static inline void menu_copy_label(wchar_t* dst, size_t cap, const wchar_t* src);
 	static inline void menu_draw_button(const Button* button);
-	static void menu_render_frame(const Button* buttons, const size_t button_count, const int width, const int height, const int high_score[3], const int difficulty);
+	static void menu_render_frame(const Button* buttons, const size_t button_count, const MenuContext* context);
+	static int menu_run(Button* buttons, const size_t button_count, const MenuDrawFunc draw, const MenuContext* context);
 
 	// 渲染菜单和游戏画面的接口
 
@@ -82,34 +94,28 @@ extern "C" {
 	 * @brief 渲染主菜单。
 	 * @return 0 = 开始游戏，1 = 选择难度，2 = 退出。
 	 */
-	int render_draw_main_menu(const int width, const int height, const int high_score[3], const int difficulty, const int fps);
+	int render_draw_main_menu(const int width, const int height, const int high_score[DIFFICULTY_COUNT], const int difficulty);
 
 	/**
 	 * @brief 渲染难度选择界面。
 	 * @return 返回选择的难度，取消则返回当前难度。
 	 */
-	int render_draw_difficulty_menu(const int width, const int height, const int difficulty, const int fps);
-
-	/**
-	 * @brief 渲染游戏画面的主要接口。
-	 */
-	void render_draw_current_frame(const GameplayVisualState* state);
+	int render_draw_difficulty_menu(const int width, const int height, const int difficulty);
 
 	/**
 	 * @brief 渲染暂停界面。
 	 * @return 0 = 返回游戏，1 = 重新开始游戏，2 = 返回主菜单，3 = 退出游戏。
 	 */
-	int render_draw_pause_menu(const int width, const int height, const int fps);
+	int render_draw_pause_menu(const int width, const int height);
 
 	/**
 	 * @brief 渲染 WASTED 页面。
 	 * @return 0 = 重新开始，1 = 返回主菜单，2 = 退出游戏。
 	 */
-	int render_draw_wasted_page(const GameplayVisualState* state, const int high_score[3], const int fps);
+	int render_draw_wasted_page(const GameplayVisualState* state, const int high_score[DIFFICULTY_COUNT]);
 
 	// 处理纹理路径有关函数
 	const wchar_t* resolve_asset_path(const wchar_t* relative_path);
-	static inline int load_internal_texture(IMAGE* img, int* flag, const wchar_t* path);
 
 #endif /* RENDER_H */
 
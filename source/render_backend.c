@@ -0,0 +1,157 @@
+/**
+ * @file render_backend.c
+ * @brief 这份源文件实现了各后端共用的游戏画面绘制流程，以及什么都不画的 null 后端。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "render_backend.h"
+#include "profiler.h"
+#include "difficulty.h"
+
+#define RENDER_TEXT_SIZE 64
+
+/**
+ * @brief 一批精灵的插值后坐标，容量不足时增长，之后一直复用。
+ */
+typedef struct RenderBatch {
+	int* xs;
+	int* ys;
+	size_t capacity;
+} RenderBatch;
+
+static RenderBatch g_render_batch = { 0 };
+
+static void render_batch_reserve(RenderBatch* batch, const size_t count) {
+	if (count <= batch->capacity) {
+		return;
+	}
+
+	size_t capacity = batch->capacity ? batch->capacity : 64;
+	while (capacity < count) {
+		capacity *= 2;
+	}
+	int* xs = (int*)realloc(batch->xs, sizeof(int) * capacity);
+	int* ys = (int*)realloc(batch->ys, sizeof(int) * capacity);
+	if (!xs || !ys) {
+		fprintf(stderr, "malloc() failed.\n");
+		exit(EXIT_FAILURE);
+	}
+	batch->xs = xs;
+	batch->ys = ys;
+	batch->capacity = capacity;
+}
+
+/**
+ * @brief 在上一 tick 与当前 tick 的坐标之间线性插值，四舍五入到整数像素。
+ */
+static inline int render_lerp(const int prev, const int current, const double alpha) {
+	const double value = prev + (current - prev) * alpha;
+	return (int)(value >= 0 ? value + 0.5 : value - 0.5);
+}
+
+static void render_pool(const RenderBackend* backend, const RenderSpriteId sprite, const ObjectPool* pool, const double alpha) {
+	if (!pool || pool->count == 0) {
+		return;
+	}
+
+	render_batch_reserve(&g_render_batch, pool->count);
+	for (size_t i = 0; i < pool->count; ++i) {
+		g_render_batch.xs[i] = render_lerp(pool->x[i] - pool->vx[i], pool->x[i], alpha);
+		g_render_batch.ys[i] = render_lerp(pool->y[i] - pool->vy[i], pool->y[i], alpha);
+	}
+	backend->draw_sprites(sprite, g_render_batch.xs, g_render_batch.ys, pool->count);
+}
+
+const wchar_t* render_difficulty_text(const int difficulty) {
+	return difficulty >= 0 && difficulty < DIFFICULTY_COUNT ? difficulty_names[difficulty] : L"未知";
+}
+
+void render_gameplay(const RenderBackend* backend, const GameplayVisualState* state) {
+	if (state == NULL) {
+		return;
+	}
+
+	PROFILE_BEGIN(PROFILE_RENDER_BACKGROUND);
+	backend->begin_frame();
+	PROFILE_END(PROFILE_RENDER_BACKGROUND);
+
+	// 文字在 present 时才画到最上层，先设置文字是为了让后端在绘制精灵之前擦掉变化前的文字。
+	PROFILE_BEGIN(PROFILE_RENDER_HUD);
+	wchar_t text[RENDER_TEXT_SIZE];
+	swprintf(text, RENDER_TEXT_SIZE, L"SCORE %d", state->score);
+	backend->draw_text(0, state->width / 2, state->height - 32, 22, true, text);
+	swprintf(text, RENDER_TEXT_SIZE, L"难度：%ls", render_difficulty_text(state->difficulty));
+	backend->draw_text(1, 12, 12, 18, false, text);
+	swprintf(text, RENDER_TEXT_SIZE, L"HP：%d / %d", state->hp, state->starting_hp > 0 ? state->starting_hp : 1);
+	backend->draw_text(2, 12, 36, 18, false, text);
+	PROFILE_END(PROFILE_RENDER_HUD);
+
+	PROFILE_BEGIN(PROFILE_RENDER_SPRITES);
+	for (int type = 0; state->pools && type < OBJECT_TYPE_COUNT; ++type) {
+		if (type != PLAYER) {
+			render_pool(backend, (RenderSpriteId)object_kinds[type].sprite, &state->pools[type], state->alpha);
+		}
+	}
+	if (state->player) {
+		const int x = render_lerp(state->player->prev_x, state->player->x, state->alpha);
+		const int y = render_lerp(state->player->prev_y, state->player->y, state->alpha);
+		backend->draw_sprites((RenderSpriteId)object_kinds[PLAYER].sprite, &x, &y, 1);
+	}
+	PROFILE_END(PROFILE_RENDER_SPRITES);
+
+	PROFILE_BEGIN(PROFILE_RENDER_PRESENT);
+	backend->present();
+	PROFILE_END(PROFILE_RENDER_PRESENT);
+}
+
+static bool null_open(const int width, const int height, const wchar_t* title) {
+	(void)width;
+	(void)height;
+	(void)title;
+	return true;
+}
+
+static void null_close() {
+}
+
+static bool null_load_textures(const wchar_t* atlas_path) {
+	(void)atlas_path;
+	return true;
+}
+
+static void null_begin_frame() {
+}
+
+static void null_draw_sprites(const RenderSpriteId sprite, const int* xs, const int* ys, const size_t count) {
+	(void)sprite;
+	(void)xs;
+	(void)ys;
+	(void)count;
+}
+
+static void null_draw_text(const int slot, const int x, const int y, const int font_size, const bool centered, const wchar_t* text) {
+	(void)slot;
+	(void)x;
+	(void)y;
+	(void)font_size;
+	(void)centered;
+	(void)text;
+}
+
+static void null_present() {
+}
+
+const RenderBackend render_backend_null = {
+	"null",
+	null_open,
+	null_close,
+	null_load_textures,
+	null_begin_frame,
+	null_draw_sprites,
+	null_draw_text,
+	null_present
+};
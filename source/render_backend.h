@@ -0,0 +1,125 @@
+/**
+ * @file render_backend.h
+ * @brief 这份头文件声明了与平台无关的渲染后端接口，以及用它绘制一帧游戏画面的函数。
+ *        后端负责窗口、纹理、成批绘制精灵、文字与提交；游戏画面如何由这些操作组成由 render_gameplay() 决定，各后端共用。
+ *        EasyX 后端见 render.h；另有什么都不画的 null 后端，以及合成到内存中帧缓冲区的 offscreen 后端，二者都不依赖 Win32，
+ *        可以在 Linux 上运行完整的模拟与渲染流程。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <wchar.h>
+#include "pool.h"
+#include "object.h"
+#include "framebuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef RENDER_BACKEND_H
+#define RENDER_BACKEND_H
+
+#define RENDER_TEXT_SLOTS 3 // 游戏画面中的文字数：分数、难度、生命值
+
+	typedef struct GameplayVisualState {
+		int width;
+		int height;
+		int score;
+		const wchar_t* death_reason;
+		const Object* player;
+		const ObjectPool* pools; // 以 ObjectType 为下标的 OBJECT_TYPE_COUNT 个对象池，玩家由 player 给出，pools[PLAYER] 不绘制
+		int difficulty;
+		int hp;
+		int starting_hp;
+		double alpha; // 渲染插值系数，取值 [0, 1]：0 表示上一 tick 的位置，1 表示当前 tick 的位置
+	} GameplayVisualState;
+
+	/**
+	 * @brief 游戏画面中的精灵。背景不是精灵，由 begin_frame 绘制。
+	 */
+	typedef enum RenderSpriteId {
+		RENDER_SPRITE_PLAYER,
+		RENDER_SPRITE_ENEMY,
+		RENDER_SPRITE_BULLET,
+		RENDER_SPRITE_COUNT
+	} RenderSpriteId;
+
+	/**
+	 * @brief 渲染后端。一帧内的调用顺序固定为 begin_frame、若干次 draw_text 与 draw_sprites、present，且都在同一个线程中。
+	 */
+	typedef struct RenderBackend {
+		const char* name;
+
+		/**
+		 * @brief 创建 width * height 的窗口或画布。
+		 */
+		bool (*open)(const int width, const int height, const wchar_t* title);
+		void (*close)();
+
+		/**
+		 * @brief 加载背景与各个精灵。图集见 atlas.h，后端可以在图集不可用时退回其他来源。
+		 * @return 有贴图没能加载时返回 false，缺少的贴图不绘制。
+		 */
+		bool (*load_textures)(const wchar_t* atlas_path);
+
+		/**
+		 * @brief 开始一帧并绘制背景。
+		 */
+		void (*begin_frame)();
+
+		/**
+		 * @brief 在 count 个左上角坐标处绘制同一个精灵。超出画面的部分被裁剪。
+		 */
+		void (*draw_sprites)(const RenderSpriteId sprite, const int* xs, const int* ys, const size_t count);
+
+		/**
+		 * @brief 设置第 slot 段文字，文字在 present 时画在所有精灵之上。centered 为 true 时 x 是文字的水平中心。
+		 *        每帧都会为每个 slot 调用一次，后端可以在文字与位置都未变化时跳过重绘。
+		 */
+		void (*draw_text)(const int slot, const int x, const int y, const int font_size, const bool centered, const wchar_t* text);
+
+		/**
+		 * @brief 结束并提交这一帧。
+		 */
+		void (*present)();
+	} RenderBackend;
+
+	extern const RenderBackend render_backend_null;
+	extern const RenderBackend render_backend_offscreen;
+
+	/**
+	 * @brief 用 backend 绘制一帧游戏画面：背景、按 ObjectType 的顺序绘制各类对象、玩家与 HUD 文字，精灵位置按 state->alpha 插值。
+	 *        每类对象使用 object_kinds 中的贴图。
+	 *        只能在一个线程中调用。
+	 */
+	void render_gameplay(const RenderBackend* backend, const GameplayVisualState* state);
+
+	/**
+	 * @brief 获取数字难度对应的文字。
+	 */
+	const wchar_t* render_difficulty_text(const int difficulty);
+
+	/**
+	 * @brief offscreen 后端最近提交的一帧，open 之前返回 NULL。用于在无窗口的环境中检查渲染结果，例如计算 framebuffer_hash()。
+	 */
+	const FramebufferImage* render_offscreen_frame();
+
+	/**
+	 * @brief offscreen 后端自 open 以来提交的帧数。
+	 */
+	size_t render_offscreen_frame_count();
+
+	/**
+	 * @brief offscreen 后端最近一帧绘制的精灵数。为 0 时这一帧只有背景，它的哈希值不能用来检查模拟结果。
+	 */
+	size_t render_offscreen_sprite_count();
+
+#endif /* RENDER_BACKEND_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
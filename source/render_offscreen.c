@@ -0,0 +1,206 @@
+/**
+ * @file render_offscreen.c
+ * @brief 这份源文件实现了 offscreen 渲染后端：用 framebuffer.c 把每一帧合成到内存中的帧缓冲区，不需要窗口，
+ *        精灵从图集读取并预乘 alpha。没有加载图集时每种精灵画成一块与碰撞盒同样大小的纯色矩形，
+ *        因此帧的哈希值仍然反映每个对象的位置。文字暂不绘制。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "render_backend.h"
+#include "atlas.h"
+#include "log.h"
+
+#define OFFSCREEN_PATH_SIZE 1024
+
+// 没有图集时各精灵的颜色，以 RenderSpriteId 为下标。
+static const uint32_t offscreen_placeholder_colors[RENDER_SPRITE_COUNT] = { 0xFF3C8CFFu, 0xFFE0403Cu, 0xFFFFE060u };
+
+static FramebufferImage g_offscreen_frame = { 0 };
+static FramebufferSprites g_offscreen_sprites = { 0 };
+static uint32_t* g_offscreen_atlas = NULL; // 图集文件的内容，背景直接引用其中的像素
+static size_t g_offscreen_frames = 0;
+static size_t g_offscreen_sprites_drawn = 0; // 本帧绘制的精灵数
+
+static FILE* offscreen_open_file(const char* path) {
+#if defined(_MSC_VER)
+	FILE* file = NULL;
+	return fopen_s(&file, path, "rb") == 0 ? file : NULL;
+#else
+	return fopen(path, "rb");
+#endif
+}
+
+static void offscreen_free_textures() {
+	framebuffer_free(&g_offscreen_sprites.player);
+	framebuffer_free(&g_offscreen_sprites.enemy);
+	framebuffer_free(&g_offscreen_sprites.bullet);
+	memset(&g_offscreen_sprites, 0, sizeof(g_offscreen_sprites));
+	free(g_offscreen_atlas);
+	g_offscreen_atlas = NULL;
+}
+
+/**
+ * @brief 用纯色矩形代替精灵，宽高取使用这种精灵的对象的碰撞盒。几类对象共用一种精灵时取其中第一类。
+ */
+static void offscreen_placeholder_textures() {
+	offscreen_free_textures();
+
+	FramebufferImage* images[RENDER_SPRITE_COUNT] = { &g_offscreen_sprites.player, &g_offscreen_sprites.enemy, &g_offscreen_sprites.bullet };
+	for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+		const ObjectKind* kind = &object_kinds[type];
+		FramebufferImage* image = images[kind->sprite];
+		if (image->pixels) {
+			continue;
+		}
+		framebuffer_init(image, kind->width, kind->height);
+		framebuffer_fill(image, offscreen_placeholder_colors[kind->sprite]);
+	}
+}
+
+static bool offscreen_open(const int width, const int height, const wchar_t* title) {
+	(void)title;
+	framebuffer_init(&g_offscreen_frame, width, height);
+	g_offscreen_frames = 0;
+	offscreen_placeholder_textures();
+	return true;
+}
+
+static void offscreen_close() {
+	framebuffer_free(&g_offscreen_frame);
+	offscreen_free_textures();
+}
+
+/**
+ * @brief 读取图集。路径按当前区域设置转换为多字节字符串。
+ */
+static bool offscreen_load_atlas(const wchar_t* atlas_path) {
+	offscreen_free_textures();
+
+	char path[OFFSCREEN_PATH_SIZE];
+	if (wcstombs(path, atlas_path, sizeof(path)) >= sizeof(path)) {
+		LOG_WARN("Atlas path is too long or not representable.");
+		return false;
+	}
+
+	FILE* file = offscreen_open_file(path);
+	if (!file) {
+		LOG_WARN("Failed to open atlas %s.", path);
+		return false;
+	}
+	fseek(file, 0, SEEK_END);
+	const long size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	// 按 uint32_t 分配，满足 atlas_parse() 的对齐要求。
+	g_offscreen_atlas = (uint32_t*)malloc(size > 0 ? (size_t)size + sizeof(uint32_t) : 1);
+	if (!g_offscreen_atlas) {
+		fprintf(stderr, "malloc() failed.\n");
+		exit(EXIT_FAILURE);
+	}
+	const bool read = size > 0 && fread(g_offscreen_atlas, 1, (size_t)size, file) == (size_t)size;
+	fclose(file);
+
+	Atlas atlas;
+	if (!read || !atlas_parse(&atlas, g_offscreen_atlas, (size_t)size)) {
+		LOG_WARN("Atlas %s is corrupt.", path);
+		offscreen_free_textures();
+		return false;
+	}
+
+	const FramebufferImage pixels = { (uint32_t*)atlas.pixels, atlas.width, atlas.height, atlas.width };
+	const char* names[] = { "background", "player", "enemy", "bullet" };
+	FramebufferImage* images[] = { &g_offscreen_sprites.background, &g_offscreen_sprites.player, &g_offscreen_sprites.enemy, &g_offscreen_sprites.bullet };
+	bool ok = true;
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+		const AtlasSprite* sprite = atlas_find(&atlas, names[i]);
+		if (!sprite) {
+			LOG_WARN("Atlas %s has no sprite named %s.", path, names[i]);
+			ok = false;
+			continue;
+		}
+
+		const FramebufferImage view = framebuffer_view(&pixels, sprite->x, sprite->y, sprite->width, sprite->height);
+		if (i == 0) {
+			*images[i] = view;
+		}
+		else {
+			framebuffer_premultiply(images[i], &view);
+		}
+	}
+	return ok;
+}
+
+/**
+ * @brief 读取图集，失败或缺少精灵时全部改用纯色矩形。
+ */
+static bool offscreen_load_textures(const wchar_t* atlas_path) {
+	if (offscreen_load_atlas(atlas_path)) {
+		return true;
+	}
+	offscreen_placeholder_textures();
+	return false;
+}
+
+static void offscreen_begin_frame() {
+	g_offscreen_sprites_drawn = 0;
+	const FramebufferImage* background = &g_offscreen_sprites.background;
+	if (!background->pixels || background->width < g_offscreen_frame.width || background->height < g_offscreen_frame.height) {
+		framebuffer_fill(&g_offscreen_frame, FRAMEBUFFER_BACKGROUND_COLOR);
+	}
+	if (background->pixels) {
+		framebuffer_copy(&g_offscreen_frame, background, 0, 0);
+	}
+}
+
+static void offscreen_draw_sprites(const RenderSpriteId sprite, const int* xs, const int* ys, const size_t count) {
+	const FramebufferImage* image = sprite == RENDER_SPRITE_PLAYER ? &g_offscreen_sprites.player :
+		sprite == RENDER_SPRITE_ENEMY ? &g_offscreen_sprites.enemy : &g_offscreen_sprites.bullet;
+	if (!image->pixels) {
+		return;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		framebuffer_blend(&g_offscreen_frame, image, xs[i], ys[i]);
+	}
+	g_offscreen_sprites_drawn += count;
+}
+
+static void offscreen_draw_text(const int slot, const int x, const int y, const int font_size, const bool centered, const wchar_t* text) {
+	(void)slot;
+	(void)x;
+	(void)y;
+	(void)font_size;
+	(void)centered;
+	(void)text;
+}
+
+static void offscreen_present() {
+	++g_offscreen_frames;
+}
+
+const RenderBackend render_backend_offscreen = {
+	"offscreen",
+	offscreen_open,
+	offscreen_close,
+	offscreen_load_textures,
+	offscreen_begin_frame,
+	offscreen_draw_sprites,
+	offscreen_draw_text,
+	offscreen_present
+};
+
+const FramebufferImage* render_offscreen_frame() {
+	return g_offscreen_frame.pixels ? &g_offscreen_frame : NULL;
+}
+
+size_t render_offscreen_frame_count() {
+	return g_offscreen_frames;
+}
+
+size_t render_offscreen_sprite_count() {
+	return g_offscreen_sprites_drawn;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file render_thread.cpp
+ * @brief 这份源文件实现了游戏画面的渲染线程。快照的交接是无锁的；互斥锁只用于暂停与恢复：
+ *        渲染线程绘制每一帧时持有它，因此 render_thread_pause() 取得锁即说明当前没有正在绘制的帧。
+ *        模拟线程从不取这把锁。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "render_thread.h"
+#include "snapshot.h"
+#include "timer.h"
+#include "log.h"
+
+#define RENDER_THREAD_IDLE_SECONDS 0.001 // 模拟线程迟迟没有发布新快照时，两次检查之间的休眠时间，单位：秒
+
+static std::mutex g_render_mutex;
+static std::condition_variable g_render_wake;
+static std::thread g_render_thread;
+static bool g_render_running = false;
+static bool g_render_active = false; // 是否正在绘制游戏画面
+static double g_render_tick_seconds = 1.0 / 60;
+static bool g_render_uncapped = false;
+static const RenderBackend* g_render_backend = NULL;
+static std::atomic<unsigned long long> g_render_frames(0);
+
+/**
+ * @brief 绘制一帧快照，插值系数取快照发布以来经过的 tick 数，最多为 1。
+ * @return 绘制的快照的发布序号，没有快照时返回 0。
+ */
+static unsigned long long render_thread_draw(const WorldSnapshot* snapshot) {
+	if (!snapshot) {
+		return 0;
+	}
+
+	const double elapsed = (timer_now() - snapshot->time) / g_render_tick_seconds;
+	const GameplayVisualState state{
+		SCREEN_WIDTH,
+		SCREEN_HEIGHT,
+		snapshot->score,
+		L"",
+		&snapshot->player,
+		snapshot->pools,
+		snapshot->difficulty,
+		snapshot->hp,
+		snapshot->starting_hp,
+		elapsed < 1 ? elapsed : 1
+	};
+	render_gameplay(g_render_backend, &state);
+	g_render_frames.fetch_add(1, std::memory_order_relaxed);
+	return snapshot->sequence;
+}
+
+static void render_thread_main() {
+	unsigned long long drawn = 0; // 上一帧绘制的快照的发布序号
+	double next_frame = 0; // 限帧率时下一帧的预计时刻
+
+	std::unique_lock<std::mutex> lock(g_render_mutex);
+	while (true) {
+		g_render_wake.wait(lock, [] { return g_render_active || !g_render_running; });
+		if (!g_render_running) {
+			break;
+		}
+
+		const WorldSnapshot* snapshot = snapshot_acquire();
+		if (g_render_uncapped || (snapshot && snapshot->sequence != drawn)) {
+			drawn = render_thread_draw(snapshot);
+			next_frame = snapshot ? snapshot->time + g_render_tick_seconds : 0;
+		}
+
+		// 休眠时不持有锁，以免 render_thread_pause() 等待。不限帧率时也要让出一次 CPU：
+		// std::mutex 不保证公平，释放后立即重新加锁可能总是抢在等待的线程之前，使 render_thread_pause() 一直取不到锁。
+		lock.unlock();
+		if (!g_render_uncapped) {
+			const double wait = next_frame - timer_now();
+			timer_sleep(wait > RENDER_THREAD_IDLE_SECONDS ? wait : RENDER_THREAD_IDLE_SECONDS);
+		}
+		else {
+			std::this_thread::yield();
+		}
+		lock.lock();
+	}
+}
+
+void render_thread_start(const RenderBackend* backend, const double tick_seconds, const bool uncapped) {
+	std::lock_guard<std::mutex> lock(g_render_mutex);
+	if (g_render_running) {
+		return;
+	}
+
+	g_render_backend = backend;
+	g_render_tick_seconds = tick_seconds;
+	g_render_uncapped = uncapped;
+	g_render_active = false;
+	g_render_running = true;
+	g_render_thread = std::thread(render_thread_main);
+
+	LOG_INFO("Render thread started with the %s backend.", backend->name);
+}
+
+void render_thread_stop() {
+	{
+		std::lock_guard<std::mutex> lock(g_render_mutex);
+		if (!g_render_running) {
+			return;
+		}
+		g_render_running = false;
+	}
+	g_render_wake.notify_all();
+	g_render_thread.join();
+}
+
+void render_thread_resume() {
+	{
+		std::lock_guard<std::mutex> lock(g_render_mutex);
+		g_render_active = true;
+	}
+	g_render_wake.notify_all();
+}
+
+void render_thread_pause() {
+	std::lock_guard<std::mutex> lock(g_render_mutex);
+	g_render_active = false;
+}
+
+unsigned long long render_thread_frame_count() {
+	return g_render_frames.load(std::memory_order_relaxed);
+}
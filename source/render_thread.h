@@ -0,0 +1,52 @@
+/**
+ * @file render_thread.h
+ * @brief 这份头文件声明了游戏画面的渲染线程。游戏进行中，渲染线程不断取得模拟线程发布的最新快照并绘制，
+ *        按快照的发布时间插值，与模拟线程互不等待；菜单界面仍由调用线程绘制，绘制之前须暂停渲染线程。
+ *        渲染线程只通过 RenderBackend 绘制，不依赖 EasyX，配合 null 或 offscreen 后端也可以在 Linux 上运行。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include "render_backend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+	/**
+	 * @brief 启动渲染线程，启动后处于暂停状态。backend 须已打开并加载了纹理，渲染线程运行期间只由它使用。
+	 * @param tick_seconds 模拟线程发布快照的间隔，单位：秒。用于计算插值系数。
+	 * @param uncapped 为 true 时不限帧率，否则每发布一份快照绘制一帧。
+	 */
+	void render_thread_start(const RenderBackend* backend, const double tick_seconds, const bool uncapped);
+
+	/**
+	 * @brief 停止并等待渲染线程退出。
+	 */
+	void render_thread_stop();
+
+	/**
+	 * @brief 开始绘制游戏画面。
+	 */
+	void render_thread_resume();
+
+	/**
+	 * @brief 停止绘制游戏画面，并等待正在绘制的一帧完成。返回后调用线程可以安全地使用 EasyX 绘制菜单。
+	 */
+	void render_thread_pause();
+
+	/**
+	 * @brief 渲染线程启动以来绘制的帧数。
+	 */
+	unsigned long long render_thread_frame_count();
+
+#endif /* RENDER_THREAD_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,176 @@
+/**
+ * @file replay.c
+ * @brief 这份源文件实现了录像的录制、保存与读取。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "replay.h"
+#include "log.h"
+
+static const char replay_magic[4] = { 'G', 'R', 'P', 'L' };
+
+static FILE* replay_open(const char* path, const char* mode) {
+#if defined(_MSC_VER)
+	FILE* file = NULL;
+	if (fopen_s(&file, path, mode)) {
+		return NULL;
+	}
+	return file;
+#else
+	return fopen(path, mode);
+#endif
+}
+
+/**
+ * @brief 以小端序写入 bytes 个字节的无符号整数。
+ */
+static void write_uint(FILE* file, uint64_t value, const int bytes) {
+	for (int i = 0; i < bytes; ++i) {
+		fputc((int)(value & 0xFF), file);
+		value >>= 8;
+	}
+}
+
+/**
+ * @brief 以小端序读取 bytes 个字节的无符号整数。
+ */
+static bool read_uint(FILE* file, uint64_t* value, const int bytes) {
+	*value = 0;
+	for (int i = 0; i < bytes; ++i) {
+		const int c = fgetc(file);
+		if (c == EOF) {
+			return false;
+		}
+		*value |= (uint64_t)c << (8 * i);
+	}
+	return true;
+}
+
+/**
+ * @brief 写入变长整数：每字节保存 7 位，最高位为 1 表示后面还有字节。
+ */
+static void write_varint(FILE* file, uint64_t value) {
+	while (value >= 0x80) {
+		fputc((int)(value & 0x7F) | 0x80, file);
+		value >>= 7;
+	}
+	fputc((int)value, file);
+}
+
+static bool read_varint(FILE* file, uint64_t* value) {
+	*value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		const int c = fgetc(file);
+		if (c == EOF) {
+			return false;
+		}
+		*value |= (uint64_t)(c & 0x7F) << shift;
+		if (!(c & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void replay_init(Replay* replay, const uint64_t seed, const int difficulty) {
+	replay->seed = seed;
+	replay->difficulty = difficulty;
+	replay->inputs = NULL;
+	replay->tick_count = 0;
+	replay->capacity = 0;
+}
+
+void replay_record(Replay* replay, const unsigned input) {
+	if (replay->tick_count == replay->capacity) {
+		const size_t new_capacity = replay->capacity ? replay->capacity * 2 : 4096;
+		unsigned char* new_inputs = (unsigned char*)realloc(replay->inputs, new_capacity);
+		if (!new_inputs) {
+			fprintf(stderr, "realloc() failed.\n");
+			exit(EXIT_FAILURE);
+		}
+
+		replay->inputs = new_inputs;
+		replay->capacity = new_capacity;
+	}
+
+	replay->inputs[replay->tick_count++] = (unsigned char)input;
+}
+
+bool replay_save(const Replay* replay, const char* path) {
+	FILE* file = replay_open(path, "wb");
+	if (!file) {
+		LOG_WARN("Failed to open replay file %s when saving.", path);
+		return false;
+	}
+
+	fwrite(replay_magic, 1, sizeof(replay_magic), file);
+	write_uint(file, REPLAY_VERSION, 1);
+	write_uint(file, replay->seed, 8);
+	write_uint(file, (uint64_t)replay->difficulty, 1);
+	write_uint(file, replay->tick_count, 4);
+
+	for (size_t i = 0; i < replay->tick_count; ) {
+		size_t run = 1;
+		while (i + run < replay->tick_count && replay->inputs[i + run] == replay->inputs[i]) {
+			++run;
+		}
+
+		fputc(replay->inputs[i], file);
+		write_varint(file, run);
+		i += run;
+	}
+
+	const bool ok = !ferror(file);
+	fclose(file);
+
+	LOG_INFO("Replay saved: %s (%zu ticks)", path, replay->tick_count);
+	return ok;
+}
+
+bool replay_load(Replay* replay, const char* path) {
+	FILE* file = replay_open(path, "rb");
+	if (!file) {
+		LOG_WARN("Failed to open replay file %s when loading.", path);
+		return false;
+	}
+
+	char magic[sizeof(replay_magic)];
+	uint64_t version, seed, difficulty, tick_count;
+	if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) || memcmp(magic, replay_magic, sizeof(magic)) ||
+		!read_uint(file, &version, 1) || version != REPLAY_VERSION ||
+		!read_uint(file, &seed, 8) || !read_uint(file, &difficulty, 1) || !read_uint(file, &tick_count, 4)) {
+		LOG_WARN("Invalid replay header: %s", path);
+		fclose(file);
+		return false;
+	}
+
+	replay_init(replay, seed, (int)difficulty);
+	while (replay->tick_count < tick_count) {
+		const int input = fgetc(file);
+		uint64_t run;
+		if (input == EOF || !read_varint(file, &run) || run == 0 || run > tick_count - replay->tick_count) {
+			LOG_WARN("Corrupted replay data: %s", path);
+			replay_free(replay);
+			fclose(file);
+			return false;
+		}
+
+		for (uint64_t i = 0; i < run; ++i) {
+			replay_record(replay, (unsigned)input);
+		}
+	}
+
+	fclose(file);
+	return true;
+}
+
+void replay_free(Replay* replay) {
+	free(replay->inputs);
+	replay->inputs = NULL;
+	replay->tick_count = replay->capacity = 0;
+}
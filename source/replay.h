@@ -0,0 +1,68 @@
+/**
+ * @file replay.h
+ * @brief 这份头文件声明了录像的录制、保存与读取。一局游戏完全由随机数种子、难度与逐 tick 的输入位掩码决定，
+ *        因此录像只需保存这三者，回放时无需窗口，并且可以比实时更快地运行。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#define REPLAY_VERSION 1
+
+	/**
+	 * @brief 内存中的录像，每个 tick 的输入占一个字节。
+	 */
+	typedef struct Replay {
+		uint64_t seed;
+		int difficulty;
+		unsigned char* inputs;
+		size_t tick_count;
+		size_t capacity;
+	} Replay;
+
+	/**
+	 * @brief 开始录制一段新录像。
+	 */
+	void replay_init(Replay* replay, const uint64_t seed, const int difficulty);
+
+	/**
+	 * @brief 追加一个 tick 的输入。
+	 */
+	void replay_record(Replay* replay, const unsigned input);
+
+	/**
+	 * @brief 保存录像。文件格式（整数均为小端序）：
+	 *        "GRPL"、版本号（1 字节）、种子（8 字节）、难度（1 字节）、tick 数（4 字节），
+	 *        之后是若干段「输入位掩码（1 字节）+ 连续重复的 tick 数（变长整数，每字节 7 位）」。
+	 *        输入通常连续许多 tick 不变，因此只记录变化处即可。
+	 * @return 是否保存成功。
+	 */
+	bool replay_save(const Replay* replay, const char* path);
+
+	/**
+	 * @brief 读取录像，成功后需调用 replay_free() 释放。
+	 * @return 文件不存在或格式错误时返回 false。
+	 */
+	bool replay_load(Replay* replay, const char* path);
+
+	/**
+	 * @brief 释放录像。
+	 */
+	void replay_free(Replay* replay);
+
+#endif /* REPLAY_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,35 @@
+/**
+ * @file rng.c
+ * @brief 这份源文件实现了 PCG32 伪随机数生成器（PCG-XSH-RR 变体）。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include "rng.h"
+
+#define RNG_MULTIPLIER 6364136223846793005ULL
+
+void rng_seed(Rng* rng, const uint64_t seed) {
+	rng->state = 0;
+	rng->increment = (seed << 1) | 1;
+	rng_next(rng);
+	rng->state += seed;
+	rng_next(rng);
+}
+
+uint32_t rng_next(Rng* rng) {
+	const uint64_t old_state = rng->state;
+	rng->state = old_state * RNG_MULTIPLIER + rng->increment;
+
+	const uint32_t xorshifted = (uint32_t)(((old_state >> 18) ^ old_state) >> 27);
+	const uint32_t rotation = (uint32_t)(old_state >> 59);
+	return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+}
+
+/**
+ * @brief 用乘法把 32 位随机数映射到 [0, bound)，比取模更均匀，且不含循环，消耗的随机数个数固定。
+ */
+uint32_t rng_below(Rng* rng, const uint32_t bound) {
+	return (uint32_t)(((uint64_t)rng_next(rng) * bound) >> 32);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file rng.h
+ * @brief 这份头文件声明了每局游戏独立的伪随机数生成器（PCG32）。相同的种子总是产生相同的随机数序列，且与平台、rand() 的实现无关。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef RNG_H
+#define RNG_H
+
+	typedef struct Rng {
+		uint64_t state;
+		uint64_t increment; // 必须为奇数
+	} Rng;
+
+	/**
+	 * @brief 用种子初始化随机数生成器。
+	 */
+	void rng_seed(Rng* rng, const uint64_t seed);
+
+	/**
+	 * @brief 生成下一个 32 位随机数。
+	 */
+	uint32_t rng_next(Rng* rng);
+
+	/**
+	 * @brief 生成 [0, bound) 内的随机数，bound 必须为正。
+	 */
+	uint32_t rng_below(Rng* rng, const uint32_t bound);
+
+#endif /* RNG_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
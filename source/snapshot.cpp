@@ -0,0 +1,88 @@
+/**
+ * @file snapshot.cpp
+ * @brief 这份源文件实现了三缓冲的模拟状态快照。三份快照中，一份属于模拟线程（正在写入），一份属于渲染线程（正在读取），
+ *        剩下一份居中，保存最近发布的快照。发布时模拟线程用自己的那份换下居中的一份并置上「新快照」标记；
+ *        渲染线程只在看到标记时才用自己的那份换下居中的一份。两个线程从不同时持有同一份快照。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <atomic>
+#include <string.h>
+#include "snapshot.h"
+#include "timer.h"
+
+#define SNAPSHOT_FRESH 4 // 居中快照的下标与此标记按位或，表示渲染线程尚未取走
+
+static WorldSnapshot g_snapshots[3];
+static std::atomic<unsigned> g_snapshot_middle(1);
+static unsigned g_snapshot_back = 0; // 只由模拟线程访问
+static unsigned g_snapshot_front = 2; // 只由渲染线程访问
+static unsigned long long g_snapshot_sequence = 0;
+
+/**
+ * @brief 复制对象池中渲染所需的字段，超出快照容量的对象被丢弃。
+ */
+static void snapshot_copy_pool(ObjectPool* dst, const ObjectPool* src) {
+	const size_t count = src->count < dst->capacity ? src->count : dst->capacity;
+	memcpy(dst->x, src->x, sizeof(int) * count);
+	memcpy(dst->y, src->y, sizeof(int) * count);
+	memcpy(dst->vx, src->vx, sizeof(int) * count);
+	memcpy(dst->vy, src->vy, sizeof(int) * count);
+	dst->count = count;
+}
+
+void snapshot_init(const size_t capacity[OBJECT_TYPE_COUNT]) {
+	for (int i = 0; i < 3; ++i) {
+		for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+			pool_init(&g_snapshots[i].pools[type], capacity[type], NULL);
+		}
+	}
+	snapshot_reset();
+}
+
+void snapshot_reset() {
+	for (int i = 0; i < 3; ++i) {
+		g_snapshots[i].sequence = 0;
+	}
+	g_snapshot_back = 0;
+	g_snapshot_middle.store(1);
+	g_snapshot_front = 2;
+}
+
+void snapshot_publish(const GameWorld* world) {
+	WorldSnapshot* snapshot = &g_snapshots[g_snapshot_back];
+
+	snapshot->sequence = ++g_snapshot_sequence;
+	snapshot->tick = world->tick;
+	snapshot->player = *world->player;
+	for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+		snapshot_copy_pool(&snapshot->pools[type], &world->pools[type]);
+	}
+	snapshot->score = world->control->score;
+	snapshot->hp = world->control->hp;
+	snapshot->starting_hp = world->starting_hp;
+	snapshot->difficulty = world->difficulty;
+	snapshot->time = timer_now();
+
+	// release 保证渲染线程换到这份快照时能看到上面的全部写入；acquire 保证换回来的那份已被渲染线程读完。
+	g_snapshot_back = g_snapshot_middle.exchange(g_snapshot_back | SNAPSHOT_FRESH, std::memory_order_acq_rel) & ~SNAPSHOT_FRESH;
+}
+
+const WorldSnapshot* snapshot_acquire() {
+	if (g_snapshot_middle.load(std::memory_order_relaxed) & SNAPSHOT_FRESH) {
+		g_snapshot_front = g_snapshot_middle.exchange(g_snapshot_front, std::memory_order_acq_rel) & ~SNAPSHOT_FRESH;
+	}
+
+	const WorldSnapshot* snapshot = &g_snapshots[g_snapshot_front];
+	return snapshot->sequence ? snapshot : NULL;
+}
+
+void snapshot_free() {
+	for (int i = 0; i < 3; ++i) {
+		for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+			pool_free(&g_snapshots[i].pools[type]);
+		}
+	}
+}
@@ -0,0 +1,68 @@
+/**
+ * @file snapshot.h
+ * @brief 这份头文件声明了模拟状态的快照。模拟线程每个 tick 把渲染所需的状态复制进一份不可变的快照并发布，
+ *        渲染线程总是取得最近发布的一份。快照以三缓冲交换：发布与取得各自只做一次原子交换，双方都不加锁、不等待对方，
+ *        因此无论渲染多慢，都不会拖慢输入采样与模拟。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "world.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+	/**
+	 * @brief 某一 tick 结束时的渲染状态。
+	 */
+	typedef struct WorldSnapshot {
+		unsigned long long sequence; // 发布序号，从 1 开始，每次发布加 1
+		unsigned long long tick;
+		double time; // 发布时单调时钟的读数，单位：秒。渲染线程据此计算插值系数
+		Object player;
+		ObjectPool pools[OBJECT_TYPE_COUNT]; // 与 GameWorld 中的对象池一一对应，只复制 x、y、vx、vy 与 count，不包含 type
+		int score;
+		int hp;
+		int starting_hp;
+		int difficulty;
+	} WorldSnapshot;
+
+	/**
+	 * @brief 分配三份快照的空间，capacity 以 ObjectType 为下标，通常取 WorldParams 中的 capacity。
+	 *        某类对象的数量超出容量时，快照中只保留前 capacity[type] 个。
+	 */
+	void snapshot_init(const size_t capacity[OBJECT_TYPE_COUNT]);
+
+	/**
+	 * @brief 丢弃已经发布的快照，之后 snapshot_acquire() 返回 NULL，直到下一次发布。只能在渲染线程不读取快照时调用。
+	 */
+	void snapshot_reset();
+
+	/**
+	 * @brief 复制模拟状态并发布。只能由模拟线程调用。
+	 */
+	void snapshot_publish(const GameWorld* world);
+
+	/**
+	 * @brief 取得最近发布的快照。返回的快照在下一次调用 snapshot_acquire() 之前保持不变。只能由渲染线程调用。
+	 * @return 尚未发布过快照时返回 NULL。
+	 */
+	const WorldSnapshot* snapshot_acquire();
+
+	/**
+	 * @brief 释放快照的空间。
+	 */
+	void snapshot_free();
+
+#endif /* SNAPSHOT_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
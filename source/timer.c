@@ -0,0 +1,47 @@
+/**
+ * @file timer.c
+ * @brief 这份源文件实现了单调时钟与休眠函数：Windows 下使用 QueryPerformanceCounter，其余平台使用 clock_gettime。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#endif
+#include "timer.h"
+
+double timer_now() {
+#if defined(_WIN32)
+	static LARGE_INTEGER frequency = { 0 };
+	LARGE_INTEGER counter;
+
+	if (frequency.QuadPart == 0) {
+		QueryPerformanceFrequency(&frequency);
+	}
+	QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#endif
+}
+
+void timer_sleep(const double seconds) {
+	if (seconds <= 0) {
+		return;
+	}
+
+#if defined(_WIN32)
+	Sleep((DWORD)(seconds * 1000));
+#else
+	struct timespec duration;
+	duration.tv_sec = (time_t)seconds;
+	duration.tv_nsec = (long)((seconds - (double)duration.tv_sec) * 1e9);
+	nanosleep(&duration, NULL);
+#endif
+}
@@ -0,0 +1,31 @@
+/**
+ * @file timer.h
+ * @brief 这份头文件声明了单调时钟与休眠函数。与 clock() 不同，单调时钟计量的是真实经过的时间，且不受系统时间调整影响。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+	/**
+	 * @brief 读取单调时钟。
+	 * @return 自某个固定起点以来经过的时间，单位：秒。只有两次读数之差有意义。
+	 */
+	double timer_now();
+
+	/**
+	 * @brief 让当前线程休眠约 seconds 秒，seconds 不为正时立即返回。实际休眠时间可能略长，调用者应以 timer_now() 为准。
+	 */
+	void timer_sleep(const double seconds);
+
+#endif /* TIMER_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
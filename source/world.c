@@ -0,0 +1,738 @@
+/**
+ * @file world.c
+ * @brief 这份源文件实现了与平台无关的游戏模拟核心。原先位于 main.cpp 中的游戏逻辑均迁移至此。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "world.h"
+#include "log.h"
+#include "profiler.h"
+#include "jobs.h"
+
+#define WORLD_BATCH_SIZE 256 // 对象池之间的碰撞判断中，一次 collision_batch() 最多判断的对象数量
+#define WORLD_GRID_MIN_TARGETS 128 // 目标少于这个数量时不建网格，每个目标直接与全部对象做批量判断，比逐个对象查询网格更快
+#define WORLD_STRESS_ENEMY_SPEED 3 // 压力测试中对象移动得更慢，在屏幕上停留得更久，单位：像素每 tick
+#define WORLD_STRESS_BULLET_SPEED 6
+#define WORLD_STRESS_BULLET_SPREAD 4 // 压力测试中扇形弹幕两端子弹的横向速度，单位：像素每 tick
+#define WORLD_ARENA_BLOCK (256 * 1024) // 一局游戏的内存区域中每个块的最小大小，默认参数下一个块即可容纳整局的模拟状态
+
+/**
+ * @brief 将以秒为单位的时间间隔换算为 tick 数，四舍五入。
+ */
+static unsigned long long seconds_to_ticks(const double seconds) {
+	return (unsigned long long)(seconds * WORLD_TICK_RATE + 0.5);
+}
+
+/**
+ * @brief 处理玩家移动。
+ */
+static void player_move(GameWorld* world, const unsigned input) {
+	Object* player = world->player;
+	const int speed = world->params.player_speed;
+
+	player->prev_x = player->x;
+	player->prev_y = player->y;
+
+	if (input & INPUT_UP) {
+		player->y -= speed;
+	}
+	if (input & INPUT_DOWN) {
+		player->y += speed;
+	}
+	if (input & INPUT_LEFT) {
+		player->x -= speed;
+	}
+	if (input & INPUT_RIGHT) {
+		player->x += speed;
+	}
+
+	// 超出边界时拉回
+	if (player->y < 0) {
+		player->y = 0;
+	}
+	if (player->y + PLAYER_HEIGHT > SCREEN_HEIGHT) {
+		player->y = SCREEN_HEIGHT - PLAYER_HEIGHT;
+	}
+	if (player->x < 0) {
+		player->x = 0;
+	}
+	if (player->x + PLAYER_WIDTH > SCREEN_WIDTH) {
+		player->x = SCREEN_WIDTH - PLAYER_WIDTH;
+	}
+}
+
+/**
+ * @brief 处理玩家开火。
+ */
+static void player_fire(GameWorld* world) {
+	const int count = world->params.bullets_per_shot;
+	const int x = world->player->x + PLAYER_WIDTH / 2 - BULLET_WIDTH / 2;
+	for (int i = 0; i < count; ++i) {
+		// 扇形弹幕：横向速度在 [-bullet_spread, bullet_spread] 内均匀分布。
+		const int vx = count > 1 ? world->params.bullet_spread * (2 * i - (count - 1)) / (count - 1) : 0;
+
+		// 子弹数量已达上限时放弃本次开火余下的子弹。
+		if (!world_spawn(world, BULLET, x, world->player->y, vx, -world->params.bullet_speed)) {
+			break;
+		}
+	}
+}
+
+/**
+ * @brief 处理敌机生成。
+ */
+static void enemy_spawn(GameWorld* world) {
+	for (int i = 0; i < world->params.enemies_per_spawn; ++i) {
+		// 敌机数量已达上限时放弃本次生成余下的敌机。
+		if (!world_spawn_enemy(world, (int)rng_below(&world->rng, SCREEN_WIDTH - ENEMY_WIDTH), -ENEMY_HEIGHT)) {
+			break;
+		}
+	}
+}
+
+/**
+ * @brief 依次应用本局已经开始的波次。波次按时间先后排列，检查过的波次不再检查。
+ */
+static void wave_update(GameWorld* world) {
+	while (world->next_wave < world->wave_count) {
+		const Wave* wave = &world->waves[world->next_wave];
+		if (world->tick < seconds_to_ticks(wave->at)) {
+			return;
+		}
+
+		world->params.min_enemy_spawn_gap = wave->min_enemy_spawn_gap;
+		world->params.enemies_per_spawn = wave->enemies_per_spawn;
+		world->params.enemy_speed = wave->enemy_speed;
+		LOG_INFO("Wave %zu started at tick %llu.", world->next_wave, world->tick);
+		++world->next_wave;
+	}
+}
+
+/**
+ * @brief 一条碰撞规则：attacker 类对象与 target 类对象相撞时双方互相扣除生命值，生命值耗尽的一方被消灭。
+ *        attacker 为 PLAYER 时扣除的是 GameControlData 中玩家的生命值。
+ */
+typedef struct CollisionRule {
+	ObjectType attacker, target;
+	bool scores; // 消灭 target 时是否为玩家加分
+} CollisionRule;
+
+/**
+ * @brief 对象池之间的规则先于与玩家的规则执行，各自按表中顺序执行，先执行的规则中被消灭的对象不再参与之后的规则。
+ *        新增一类对象只需在 ObjectType、object_kinds 与这张表中各加一项，见 object.h。
+ */
+static const CollisionRule collision_rules[] = {
+	{ BULLET, ENEMY, true },
+	{ PLAYER, ENEMY, false },
+};
+
+#define COLLISION_RULE_COUNT (sizeof(collision_rules) / sizeof(collision_rules[0]))
+
+/**
+ * @brief 一次对象池之间的碰撞判断，作为分块并行时的上下文。
+ */
+typedef struct CollisionPass {
+	GameWorld* world;
+	const CollisionRule* rule;
+} CollisionPass;
+
+/**
+ * @brief 移动所有对象池中的对象，并删除完全离开屏幕的对象。
+ */
+static void objects_move(GameWorld* world) {
+	for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+		const ObjectKind* kind = &object_kinds[type];
+		if (world->pools[type].count == 0) {
+			continue;
+		}
+
+		const size_t erased = pool_integrate(&world->pools[type], -kind->width, -kind->height, SCREEN_WIDTH, SCREEN_HEIGHT);
+		if (erased) {
+			LOG_DEBUG("%zu objects of kind %s have been erased. (out of bound)", erased, kind->name);
+		}
+	}
+}
+
+/**
+ * @brief 找出与左上角位于 (x, y) 的 attacker 类对象相交的、下标最小的至多 limit 个 target 类对象，按下标升序写入 targets。
+ *        skip 不为 NULL 时跳过其中已被标记的对象。
+ *        每次 collision_batch() 最多判断 WORLD_BATCH_SIZE 个对象，掩码放在栈上，因此可以在多个线程中同时调用。
+ * @return 找到的对象数量。
+ */
+static size_t collision_find_targets(const GameWorld* world, const CollisionRule* rule, const int x, const int y,
+	const unsigned char* skip, size_t* targets, const size_t limit) {
+	const Grid* grid = &world->grids[rule->target];
+	const ObjectKind* attacker = &object_kinds[rule->attacker], * target = &object_kinds[rule->target];
+
+	int col_begin, col_end, row_begin, row_end;
+	grid_query_range(grid, x, y, attacker->width, attacker->height, &col_begin, &col_end, &row_begin, &row_end);
+	if (grid_range_empty(grid, col_begin, col_end, row_begin, row_end)) {
+		return 0;
+	}
+
+	uint32_t mask[COLLISION_MASK_WORDS(WORLD_BATCH_SIZE) + 1];
+	size_t found = 0;
+	for (int row = row_begin; row <= row_end; ++row) {
+		for (int col = col_begin; col <= col_end; ++col) {
+			const int cell = row * grid->cols + col;
+			const size_t begin = grid->cell_start[cell], count = grid->cell_start[cell + 1] - begin;
+
+			for (size_t base = 0; base < count; base += WORLD_BATCH_SIZE) {
+				// 格子内的对象按下标升序排列，已经找满且剩余对象的下标都更大时即可结束本格的判断。
+				if (found == limit && grid->items[begin + base] >= targets[limit - 1]) {
+					break;
+				}
+
+				const size_t n = count - base < WORLD_BATCH_SIZE ? count - base : WORLD_BATCH_SIZE;
+				if (collision_batch(x, y, attacker->width, attacker->height, grid->item_x + begin + base, grid->item_y + begin + base,
+					n, target->width, target->height, mask) == 0) {
+					continue;
+				}
+
+				for (size_t k = 0; k < n; ++k) {
+					const size_t i = grid->items[begin + base + k];
+					if (found == limit && i >= targets[limit - 1]) {
+						break;
+					}
+					if (!(mask[k / 32] >> (k % 32) & 1) || (skip && skip[i])) {
+						continue;
+					}
+
+					// 插入有序的 targets，已满时挤掉下标最大的一个。
+					size_t p = found < limit ? found++ : limit - 1;
+					while (p > 0 && targets[p - 1] > i) {
+						targets[p] = targets[p - 1];
+						--p;
+					}
+					targets[p] = i;
+				}
+			}
+		}
+	}
+
+	return found;
+}
+
+/**
+ * @brief 第一阶段的一块：为下标 [begin, end) 的 attacker 类对象找出候选目标。只读取网格与 attacker 类对象的坐标，各块之间互不影响。
+ */
+static void collision_candidates_chunk(void* context, const size_t begin, const size_t end, const size_t chunk) {
+	const CollisionPass* pass = (const CollisionPass*)context;
+	GameWorld* world = pass->world;
+	const ObjectPool* attackers = &world->pools[pass->rule->attacker];
+	(void)chunk;
+
+	for (size_t j = begin; j < end; ++j) {
+		world->candidate_count[j] = (unsigned char)collision_find_targets(world, pass->rule, attackers->x[j], attackers->y[j], NULL,
+			world->candidates + j * WORLD_HIT_CANDIDATES, WORLD_HIT_CANDIDATES);
+	}
+}
+
+/**
+ * @brief 目标较少（不足 WORLD_GRID_MIN_TARGETS 个）时第一阶段的一块，结果与 collision_candidates_chunk() 相同。
+ *        这一块的对象比目标少时，每个对象与全部目标连续存放的坐标做一次批量判断；
+ *        否则每个目标依次与这一块的对象做批量判断，按目标下标升序记录到各个对象的候选中。
+ */
+static void collision_direct_chunk(void* context, const size_t begin, const size_t end, const size_t chunk) {
+	const CollisionPass* pass = (const CollisionPass*)context;
+	GameWorld* world = pass->world;
+	const ObjectPool* attackers = &world->pools[pass->rule->attacker], * targets = &world->pools[pass->rule->target];
+	const ObjectKind* attacker = &object_kinds[pass->rule->attacker], * target = &object_kinds[pass->rule->target];
+	uint32_t mask[COLLISION_MASK_WORDS(WORLD_BATCH_SIZE > WORLD_GRID_MIN_TARGETS ? WORLD_BATCH_SIZE : WORLD_GRID_MIN_TARGETS) + 1];
+	(void)chunk;
+
+	if (end - begin < targets->count) {
+		for (size_t j = begin; j < end; ++j) {
+			size_t* candidates = world->candidates + j * WORLD_HIT_CANDIDATES;
+			size_t found = 0;
+			if (collision_batch(attackers->x[j], attackers->y[j], attacker->width, attacker->height, targets->x, targets->y,
+				targets->count, target->width, target->height, mask) != 0) {
+				for (size_t i = 0; i < targets->count && found < WORLD_HIT_CANDIDATES; ++i) {
+					if (mask[i / 32] >> (i % 32) & 1) {
+						candidates[found++] = i;
+					}
+				}
+			}
+			world->candidate_count[j] = (unsigned char)found;
+		}
+		return;
+	}
+
+	memset(world->candidate_count + begin, 0, end - begin);
+	for (size_t base = begin; base < end; base += WORLD_BATCH_SIZE) {
+		const size_t n = end - base < WORLD_BATCH_SIZE ? end - base : WORLD_BATCH_SIZE;
+		for (size_t i = 0; i < targets->count; ++i) {
+			if (collision_batch(targets->x[i], targets->y[i], target->width, target->height, attackers->x + base, attackers->y + base,
+				n, attacker->width, attacker->height, mask) == 0) {
+				continue;
+			}
+
+			// 命中很少，逐字检查，跳过全为 0 的字以及字中最高的 1 之后的位。
+			for (size_t w = 0; w < COLLISION_MASK_WORDS(n); ++w) {
+				uint32_t bits = mask[w];
+				for (size_t k = w * 32; bits != 0 && k < n; ++k, bits >>= 1) {
+					unsigned char* count = &world->candidate_count[base + k];
+					if ((bits & 1) && *count < WORLD_HIT_CANDIDATES) {
+						world->candidates[(base + k) * WORLD_HIT_CANDIDATES + (*count)++] = i;
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief 目标较少时代替 collision_find_targets() 单独查找：与全部目标做一次批量判断，返回未被消灭的、下标最小的一个。
+ * @return 未撞上时返回目标数量。
+ */
+static size_t collision_find_direct(GameWorld* world, const CollisionRule* rule, const int x, const int y, const unsigned char* skip) {
+	const ObjectPool* targets = &world->pools[rule->target];
+	const ObjectKind* attacker = &object_kinds[rule->attacker], * target = &object_kinds[rule->target];
+
+	if (collision_batch(x, y, attacker->width, attacker->height, targets->x, targets->y, targets->count,
+		target->width, target->height, world->hit_mask) == 0) {
+		return targets->count;
+	}
+	for (size_t i = 0; i < targets->count; ++i) {
+		if ((world->hit_mask[i / 32] >> (i % 32) & 1) && !skip[i]) {
+			return i;
+		}
+	}
+	return targets->count;
+}
+
+/**
+ * @brief 目标是否足够多、值得为它建网格。
+ */
+static bool collision_use_grid(const GameWorld* world, const ObjectType target) {
+	return world->grids[target].cols > 0 && world->pools[target].count >= WORLD_GRID_MIN_TARGETS;
+}
+
+/**
+ * @brief 对象 i 受到 damage 点伤害，生命值耗尽时标记为已消灭。
+ * @return 是否在这次伤害中被消灭。
+ */
+static bool object_damage(GameWorld* world, const ObjectType type, const size_t i, const int damage) {
+	ObjectPool* pool = &world->pools[type];
+	pool->hp[i] -= damage;
+	if (pool->hp[i] > 0) {
+		return false;
+	}
+
+	world->destroyed[type][i] = 1;
+	LOG_DEBUG("An object of kind %s has been destroyed.", object_kinds[type].name);
+	return true;
+}
+
+/**
+ * @brief 对所有未被消灭的 attacker 类对象，判断其是否撞上 target 类对象。
+ *        target 类对象较多时放入均匀网格，每个 attacker 类对象只与其附近格子中的对象做批量判断；
+ *        较少时不建网格，每个目标直接与全部 attacker 类对象连续存放的坐标做批量判断。
+ *        一个对象撞上多个目标时，只与尚未被消灭的、下标最小的那一个相撞。
+ *        判断分两个阶段：第一阶段分块并行，为每个 attacker 类对象记录与之相交的、下标最小的几个目标；
+ *        第二阶段在调用线程上按下标顺序依次认领，因此结果与线程数无关。候选目标都已被消灭时再单独查找一次。
+ *        网格中保存的是对象下标，因此被消灭的对象只做标记，由 objects_erase_destroyed() 统一删除。
+ */
+static void pool_collision(GameWorld* world, const CollisionRule* rule) {
+	ObjectPool* attackers = &world->pools[rule->attacker], * targets = &world->pools[rule->target];
+	unsigned char* attacker_destroyed = world->destroyed[rule->attacker], * target_destroyed = world->destroyed[rule->target];
+	const ObjectKind* attacker = &object_kinds[rule->attacker], * target = &object_kinds[rule->target];
+
+	if (attackers->count == 0 || targets->count == 0) {
+		return;
+	}
+
+	CollisionPass pass = { world, rule };
+	const bool use_grid = collision_use_grid(world, rule->target);
+	jobs_parallel_for(attackers->count, WORLD_COLLISION_GRAIN, use_grid ? collision_candidates_chunk : collision_direct_chunk, &pass);
+
+	for (size_t j = 0; j < attackers->count; ++j) {
+		if (attacker_destroyed[j]) {
+			continue;
+		}
+
+		const size_t* candidates = world->candidates + j * WORLD_HIT_CANDIDATES;
+		const size_t candidate_count = world->candidate_count[j];
+
+		size_t hit = targets->count; // 被撞上的目标下标，等于 count 表示未撞上
+		for (size_t k = 0; k < candidate_count; ++k) {
+			if (!target_destroyed[candidates[k]]) {
+				hit = candidates[k];
+				break;
+			}
+		}
+		if (hit == targets->count && candidate_count == WORLD_HIT_CANDIDATES) {
+			if (use_grid) {
+				collision_find_targets(world, rule, attackers->x[j], attackers->y[j], target_destroyed, &hit, 1);
+			}
+			else {
+				hit = collision_find_direct(world, rule, attackers->x[j], attackers->y[j], target_destroyed);
+			}
+		}
+
+		if (hit < targets->count) {
+			if (object_damage(world, rule->target, hit, attacker->damage) && rule->scores) {
+				game_control_add_score(world->control, target->points);
+			}
+			object_damage(world, rule->attacker, j, target->damage);
+		}
+	}
+}
+
+/**
+ * @brief 对所有未被消灭的 target 类对象，判断其是否与玩家碰撞。
+ *        玩家只有一个，因此不经网格粗筛，直接与池中连续存放的全部坐标做一次批量判断。
+ */
+static void player_collision(GameWorld* world, const CollisionRule* rule) {
+	const Object* player = world->player;
+	const ObjectPool* targets = &world->pools[rule->target];
+	const ObjectKind* attacker = &object_kinds[PLAYER], * target = &object_kinds[rule->target];
+
+	if (collision_batch(player->x, player->y, attacker->width, attacker->height,
+		targets->x, targets->y, targets->count, target->width, target->height, world->hit_mask) == 0) {
+		return;
+	}
+
+	for (size_t i = 0; i < targets->count; ++i) {
+		if ((world->hit_mask[i / 32] >> (i % 32) & 1) && !world->destroyed[rule->target][i]) {
+			if (object_damage(world, rule->target, i, attacker->damage) && rule->scores) {
+				game_control_add_score(world->control, target->points);
+			}
+			game_control_reduce_hp(world->control, target->damage * world->params.delta_hp);
+		}
+	}
+}
+
+/**
+ * @brief 删除本 tick 被消灭的对象。
+ *        从后往前删除，这样换到空位上的总是已经检查过标记的、下标更大的存活对象。
+ */
+static void objects_erase_destroyed(GameWorld* world) {
+	for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+		ObjectPool* pool = &world->pools[type];
+		for (size_t i = pool->count; i-- > 0; ) {
+			if (world->destroyed[type][i]) {
+				pool_erase(pool, i);
+			}
+		}
+	}
+}
+
+/**
+ * @brief 依次执行所有碰撞规则。对象池之间的碰撞计入 PROFILE_COLLISION_BULLET，与玩家的碰撞以及删除被消灭的对象计入 PROFILE_COLLISION_PLAYER。
+ */
+static void objects_collide(GameWorld* world) {
+	PROFILE_BEGIN(PROFILE_COLLISION_BULLET);
+	for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+		const ObjectPool* pool = &world->pools[type];
+		if (collision_use_grid(world, (ObjectType)type)) {
+			grid_build(&world->grids[type], pool->x, pool->y, pool->count);
+		}
+		memset(world->destroyed[type], 0, pool->count);
+	}
+	for (size_t r = 0; r < COLLISION_RULE_COUNT; ++r) {
+		if (collision_rules[r].attacker != PLAYER) {
+			pool_collision(world, &collision_rules[r]);
+		}
+	}
+	PROFILE_END(PROFILE_COLLISION_BULLET);
+
+	PROFILE_BEGIN(PROFILE_COLLISION_PLAYER);
+	for (size_t r = 0; r < COLLISION_RULE_COUNT; ++r) {
+		if (collision_rules[r].attacker == PLAYER) {
+			player_collision(world, &collision_rules[r]);
+		}
+	}
+	objects_erase_destroyed(world);
+	PROFILE_END(PROFILE_COLLISION_PLAYER);
+}
+
+/**
+ * @brief 取得某一难度的默认参数。
+ */
+WorldParams world_default_params(const int difficulty) {
+	WorldParams params;
+	params.delta_hp = delta_hp[difficulty];
+	params.min_fire_gap = min_fire_gap[difficulty];
+	params.min_enemy_spawn_gap = min_enemy_spawn_gap[difficulty];
+	params.player_speed = player_speed[difficulty];
+	params.enemy_speed = enemy_speed[difficulty];
+	params.bullet_speed = bullet_speed[difficulty];
+	for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+		params.capacity[type] = type == PLAYER ? 0 : WORLD_POOL_CAPACITY;
+	}
+	params.bullets_per_shot = 1;
+	params.bullet_spread = 0;
+	params.enemies_per_spawn = 1;
+	params.scripted_waves = true;
+	return params;
+}
+
+/**
+ * @brief 取得压力测试的参数。
+ */
+WorldParams world_stress_params(const size_t entities) {
+	WorldParams params = world_default_params(DIFFICULTY_COUNT - 1);
+	params.delta_hp = 0;
+	params.min_fire_gap = 0;
+	params.min_enemy_spawn_gap = 0;
+	params.enemy_speed = WORLD_STRESS_ENEMY_SPEED;
+	params.bullet_speed = WORLD_STRESS_BULLET_SPEED;
+	params.capacity[ENEMY] = entities / 2;
+	params.capacity[BULLET] = entities - entities / 2;
+	params.bullet_spread = WORLD_STRESS_BULLET_SPREAD;
+	params.scripted_waves = false;
+
+	// 对象在屏幕上停留的 tick 数乘以每 tick 生成的数量即为同时存活的数量。
+	const size_t enemy_lifetime = (SCREEN_HEIGHT + ENEMY_HEIGHT) / WORLD_STRESS_ENEMY_SPEED;
+	const size_t bullet_lifetime = SCREEN_HEIGHT / WORLD_STRESS_BULLET_SPEED;
+	const size_t enemies = (params.capacity[ENEMY] + enemy_lifetime - 1) / enemy_lifetime;
+	const size_t bullets = (params.capacity[BULLET] + bullet_lifetime - 1) / bullet_lifetime;
+	params.enemies_per_spawn = enemies > 1 ? (int)enemies : 1;
+	params.bullets_per_shot = bullets > 1 ? (int)bullets : 1;
+	return params;
+}
+
+/**
+ * @brief 按照某一难度的默认参数初始化一局游戏的模拟状态。
+ */
+void world_init(GameWorld* world, GameControlData* control, const int difficulty, const uint64_t seed) {
+	const WorldParams params = world_default_params(difficulty);
+	world_init_with_params(world, control, difficulty, &params, seed);
+}
+
+/**
+ * @brief 从 world->arena 中划分一局游戏的模拟状态并初始化。
+ */
+static void world_setup(GameWorld* world, GameControlData* control, const int difficulty, const WorldParams* params, const uint64_t seed) {
+	Arena* arena = &world->arena;
+	world->player = (Object*)arena_alloc(arena, sizeof(Object));
+
+	world->player->x = world->player->prev_x = SCREEN_WIDTH / 2 - PLAYER_WIDTH / 2;
+	world->player->y = world->player->prev_y = SCREEN_HEIGHT - PLAYER_HEIGHT - 100;
+	world->player->type = PLAYER;
+
+	world->params = *params;
+	const size_t* capacity = params->capacity;
+	size_t max_capacity = 1;
+	for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+		pool_init(&world->pools[type], capacity[type], arena);
+		world->destroyed[type] = (unsigned char*)arena_alloc(arena, capacity[type] ? capacity[type] : 1);
+		if (capacity[type] > max_capacity) {
+			max_capacity = capacity[type];
+		}
+	}
+
+	/**
+	 * 会被其他对象池中的对象撞上的每类对象各建一个网格。格子宽高分别取这类对象与撞向它的最大对象的宽高之和，
+	 * 这样每个对象最多只需检查 2 × 2 个格子。网格纵向上下各多留一格，覆盖刚生成于屏幕上方、以及即将离开屏幕底端的对象。
+	 */
+	memset(world->grids, 0, sizeof(world->grids));
+	for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+		const ObjectKind* kind = &object_kinds[type];
+		int attacker_width = 0, attacker_height = 0;
+		for (size_t r = 0; r < COLLISION_RULE_COUNT; ++r) {
+			const ObjectKind* attacker = &object_kinds[collision_rules[r].attacker];
+			if (collision_rules[r].target == (ObjectType)type && collision_rules[r].attacker != PLAYER) {
+				attacker_width = attacker->width > attacker_width ? attacker->width : attacker_width;
+				attacker_height = attacker->height > attacker_height ? attacker->height : attacker_height;
+			}
+		}
+		if (attacker_width > 0) {
+			grid_init(&world->grids[type], 0, -kind->height, SCREEN_WIDTH, SCREEN_HEIGHT + 2 * kind->height,
+				kind->width + attacker_width, kind->height + attacker_height, kind->width, kind->height, capacity[type], arena);
+		}
+	}
+	world->hit_mask = (uint32_t*)arena_alloc(arena, sizeof(uint32_t) * (COLLISION_MASK_WORDS(max_capacity) + 1));
+	world->candidates = (size_t*)arena_alloc(arena, sizeof(size_t) * WORLD_HIT_CANDIDATES * max_capacity);
+	world->candidate_count = (unsigned char*)arena_alloc(arena, max_capacity);
+
+	world->difficulty = difficulty;
+	world->control = control;
+	rng_seed(&world->rng, seed);
+	world->tick = 0;
+	world->last_bullet_spawn_tick = world->last_enemy_spawn_tick = 0;
+
+	/**
+	 * 本局用到的参数表内容在开局时复制一份：按 F5 重新加载 difficulty.cfg 只影响之后开始的对局，
+	 * 进行中的一局与它的录像回放时使用的仍是同一份参数。
+	 */
+	world->starting_hp = starting_hp[difficulty];
+	world->wave_count = 0;
+	for (size_t i = 0; params->scripted_waves && i < difficulty_wave_count; ++i) {
+		world->wave_count += difficulty_waves[i].difficulty == difficulty;
+	}
+	world->waves = (Wave*)arena_alloc(arena, sizeof(Wave) * (world->wave_count ? world->wave_count : 1));
+	for (size_t i = 0, k = 0; k < world->wave_count; ++i) {
+		if (difficulty_waves[i].difficulty == difficulty) {
+			world->waves[k++] = difficulty_waves[i];
+		}
+	}
+	world->next_wave = 0;
+}
+
+/**
+ * @brief 按照给定的参数初始化一局游戏的模拟状态。
+ */
+void world_init_with_params(GameWorld* world, GameControlData* control, const int difficulty, const WorldParams* params, const uint64_t seed) {
+	arena_init(&world->arena, WORLD_ARENA_BLOCK);
+	world_setup(world, control, difficulty, params, seed);
+}
+
+/**
+ * @brief 在原有的内存上开始新的一局。
+ */
+void world_restart(GameWorld* world, const int difficulty, const WorldParams* params, const uint64_t seed) {
+	arena_reset(&world->arena);
+	world_setup(world, world->control, difficulty, params, seed);
+}
+
+/**
+ * @brief 在指定位置直接生成一个某类对象，不受生成间隔限制。
+ */
+bool world_spawn(GameWorld* world, const ObjectType type, const int x, const int y, const int vx, const int vy) {
+	return pool_spawn(&world->pools[type], x, y, vx, vy, type);
+}
+
+/**
+ * @brief 在指定位置直接生成一架敌机，不受生成间隔限制。
+ */
+bool world_spawn_enemy(GameWorld* world, const int x, const int y) {
+	return world_spawn(world, ENEMY, x, y, 0, world->params.enemy_speed);
+}
+
+/**
+ * @brief 在指定位置直接生成一颗子弹，不受开火间隔限制。
+ */
+bool world_spawn_bullet(GameWorld* world, const int x, const int y) {
+	return world_spawn(world, BULLET, x, y, 0, -world->params.bullet_speed);
+}
+
+/**
+ * @brief 判断下一个 tick 按下开火键时能否开火，即距上次开火的间隔是否足够。
+ */
+bool world_can_fire(const GameWorld* world) {
+	return world->tick + 1 - world->last_bullet_spawn_tick >= seconds_to_ticks(world->params.min_fire_gap);
+}
+
+/**
+ * @brief 按照本 tick 的输入位掩码推进一个 tick。
+ */
+void world_step(GameWorld* world, const unsigned input) {
+	++world->tick;
+
+	PROFILE_BEGIN(PROFILE_MOVE);
+	player_move(world, input);
+	PROFILE_END(PROFILE_MOVE);
+
+	PROFILE_BEGIN(PROFILE_SPAWN);
+
+	// 检查开火键是否被按下。
+	if (input & INPUT_FIRE) {
+		// 检查本次开火与上次开火的时间间隔是否足够。
+		if (world->tick - world->last_bullet_spawn_tick >= seconds_to_ticks(world->params.min_fire_gap)) {
+			player_fire(world);
+			world->last_bullet_spawn_tick = world->tick; // 更新最后一次子弹生成时间。
+
+			LOG_DEBUG("A bullet has been fired.");
+		}
+	}
+
+	wave_update(world);
+
+	// 检查本次敌机生成与上次敌机生成的时间间隔是否足够。
+	if (world->tick - world->last_enemy_spawn_tick >= seconds_to_ticks(world->params.min_enemy_spawn_gap)) {
+		enemy_spawn(world);
+		world->last_enemy_spawn_tick = world->tick; // 更新最后一次敌机生成时间。
+
+		LOG_DEBUG("An enemy has been spawned.");
+	}
+
+	PROFILE_END(PROFILE_SPAWN);
+
+	PROFILE_BEGIN(PROFILE_MOVE);
+	objects_move(world);
+	PROFILE_END(PROFILE_MOVE);
+
+	objects_collide(world);
+}
+
+/**
+ * @brief 各对象池中同时存活的对象总数。
+ */
+size_t world_object_count(const GameWorld* world) {
+	size_t count = 0;
+	for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+		count += world->pools[type].count;
+	}
+	return count;
+}
+
+/**
+ * @brief 将 bytes 个字节并入 FNV-1a 哈希值。
+ */
+static uint64_t hash_bytes(uint64_t hash, const void* data, const size_t bytes) {
+	const unsigned char* p = (const unsigned char*)data;
+	for (size_t i = 0; i < bytes; ++i) {
+		hash = (hash ^ p[i]) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+/**
+ * @brief 将一个整数并入哈希值。逐个字段处理而不是直接哈希结构体，避免结构体填充字节的影响。
+ */
+static uint64_t hash_int(const uint64_t hash, const long long value) {
+	return hash_bytes(hash, &value, sizeof(value));
+}
+
+static uint64_t hash_pool(uint64_t hash, const ObjectPool* pool) {
+	hash = hash_int(hash, (long long)pool->count);
+	for (size_t i = 0; i < pool->count; ++i) {
+		hash = hash_int(hash, pool->x[i]);
+		hash = hash_int(hash, pool->y[i]);
+	}
+	return hash;
+}
+
+/**
+ * @brief 计算模拟状态的哈希值。
+ */
+uint64_t world_hash(const GameWorld* world) {
+	uint64_t hash = 14695981039346656037ULL;
+	hash = hash_int(hash, (long long)world->tick);
+	hash = hash_int(hash, (long long)world->rng.state);
+	hash = hash_int(hash, world->control->score);
+	hash = hash_int(hash, world->control->hp);
+	hash = hash_int(hash, world->player->x);
+	hash = hash_int(hash, world->player->y);
+	// 玩家单独存放，跳过总是为空的 pools[PLAYER]。
+	for (int type = 0; type < OBJECT_TYPE_COUNT; ++type) {
+		if (type != PLAYER) {
+			hash = hash_pool(hash, &world->pools[type]);
+		}
+	}
+	return hash;
+}
+
+/**
+ * @brief 释放一局游戏的模拟状态。
+ */
+void world_free(GameWorld* world) {
+	arena_free(&world->arena);
+	memset(world->pools, 0, sizeof(world->pools));
+	memset(world->grids, 0, sizeof(world->grids));
+	memset(world->destroyed, 0, sizeof(world->destroyed));
+	world->hit_mask = NULL;
+	world->candidates = NULL;
+	world->candidate_count = NULL;
+	world->waves = NULL;
+	world->wave_count = 0;
+	world->player = NULL;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file world.h
+ * @brief 这份头文件声明了与平台无关的游戏模拟核心 GameWorld。
+ *        模拟核心不依赖窗口、EasyX 与 Win32，每个 tick 只接收一个输入位掩码，因此可以在 Linux 上无窗口运行。
+ * @author 陆营
+ * @date 2026-10-18
+ * @version v1.0
+ */
+
+#include <stdbool.h>
+#include "pool.h"
+#include "grid.h"
+#include "collision.h"
+#include "rng.h"
+#include "arena.h"
+#include "difficulty.h"
+#include "object.h"
+#include "control.h"
+#include "high_score_save_load.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifndef WORLD_H
+#define WORLD_H
+
+#define SCREEN_WIDTH 600
+#define SCREEN_HEIGHT 800
+#define WORLD_TICK_RATE 60 // 模拟频率，单位：tick 每秒
+
+#define WORLD_POOL_CAPACITY 1024 // 默认参数下每类对象同时存活的数量上限
+
+#define WORLD_HIT_CANDIDATES 4 // 并行碰撞判断时每个对象记录的候选目标数量
+#define WORLD_COLLISION_GRAIN 1024 // 并行碰撞判断时每块包含的对象数
+
+	/**
+	 * @brief 每个 tick 的输入位掩码中各个按键对应的位。
+	 */
+	typedef enum InputBit {
+		INPUT_UP = 1 << 0,
+		INPUT_DOWN = 1 << 1,
+		INPUT_LEFT = 1 << 2,
+		INPUT_RIGHT = 1 << 3,
+		INPUT_FIRE = 1 << 4
+	} InputBit;
+
+#define INPUT_GAME_MASK 0x1F // 模拟核心使用的位，更高的位留给界面（暂停、调试用的按键等），不写入录像
+
+	/**
+	 * @brief 一局游戏使用的参数。默认取自 difficulty.h 中各难度的参数表，也可以在初始化前修改，用于基准测试等场景。
+	 */
+	typedef struct WorldParams {
+		int delta_hp;
+		double min_fire_gap; // 单位：秒
+		double min_enemy_spawn_gap; // 单位：秒
+		int player_speed; // 单位：像素每 tick
+		int enemy_speed; // 单位：像素每 tick
+		int bullet_speed; // 单位：像素每 tick
+		size_t capacity[OBJECT_TYPE_COUNT]; // 每类对象同时存活的数量上限。玩家不放在对象池中，capacity[PLAYER] 为 0
+		int bullets_per_shot; // 每次开火射出的子弹数，多于一颗时呈扇形散开
+		int bullet_spread; // 扇形两端子弹的横向速度，单位：像素每 tick
+		int enemies_per_spawn; // 每次生成的敌机数
+		bool scripted_waves; // 是否按本难度的波次表随时间调整敌机的生成参数
+	} WorldParams;
+
+	/**
+	 * @brief 一局游戏的全部模拟状态。时间以 tick 计数，而非 clock()，因此模拟结果与机器负载无关。
+	 */
+	typedef struct GameWorld {
+		Arena arena; // 本局的全部内存，包括下列所有指针指向的空间
+		Object* player;
+		ObjectPool pools[OBJECT_TYPE_COUNT]; // 每类对象一个池，池中的数组即为这类对象各自的组件。玩家单独存放在 player 中，pools[PLAYER] 为空
+		Grid grids[OBJECT_TYPE_COUNT]; // 会被其他对象池中的对象撞上的各类对象每个 tick 重建的网格，用于碰撞粗筛
+		unsigned char* destroyed[OBJECT_TYPE_COUNT]; // 本 tick 生命值耗尽、等待删除的对象标记，长度与对应的池相同
+		uint32_t* hit_mask; // collision_batch() 的输出，长度为 COLLISION_MASK_WORDS(最大的池容量)
+		size_t* candidates; // 碰撞判断中每个对象可能撞上的、下标最小的 WORLD_HIT_CANDIDATES 个对象，长度为 WORLD_HIT_CANDIDATES * 最大的池容量
+		unsigned char* candidate_count; // 每个对象实际记录的候选对象数量，长度为最大的池容量
+		int difficulty;
+		int starting_hp; // 开局时取自 starting_hp 表，供 HUD 显示
+		WorldParams params;
+		GameControlData* control; // 得分与生命值的归属，由调用者持有。
+		Rng rng; // 本局专用的随机数生成器，相同的种子与输入序列总是得到相同的结果
+		unsigned long long tick; // 本局已经模拟的 tick 数
+		unsigned long long last_bullet_spawn_tick, last_enemy_spawn_tick;
+		Wave* waves; // 本局难度的各个波次，开局时从 difficulty_waves 中复制，重新加载 difficulty.cfg 不影响进行中的一局
+		size_t wave_count; // 不按波次表调整时为 0
+		size_t next_wave; // waves 中下一个待检查的波次
+	} GameWorld;
+
+	/**
+	 * @brief 取得某一难度的默认参数。
+	 */
+	WorldParams world_default_params(const int difficulty);
+
+	/**
+	 * @brief 取得压力测试的参数：玩家不会死亡，每个 tick 都开火并生成敌机，扇形弹幕与敌机的数量按 entities 计算，
+	 *        不计碰撞时恰好填满各自的容量（敌机与子弹各占一半）。用于观察同时存活的对象数与每 tick 耗时的关系。
+	 */
+	WorldParams world_stress_params(const size_t entities);
+
+	/**
+	 * @brief 按照某一难度的默认参数初始化一局游戏的模拟状态。
+	 */
+	void world_init(GameWorld* world, GameControlData* control, const int difficulty, const uint64_t seed);
+
+	/**
+	 * @brief 按照给定的参数初始化一局游戏的模拟状态。difficulty 只用于显示与记录最高分。
+	 */
+	void world_init_with_params(GameWorld* world, GameControlData* control, const int difficulty, const WorldParams* params, const uint64_t seed);
+
+	/**
+	 * @brief 在已初始化的模拟状态上开始新的一局：O(1) 地重置本局的内存区域后重新划分，不释放也不申请内存
+	 *        （参数所需的空间变大时除外），耗时与上一局存活的对象数无关。得分与生命值仍归原来的 control。
+	 */
+	void world_restart(GameWorld* world, const int difficulty, const WorldParams* params, const uint64_t seed);
+
+	/**
+	 * @brief 在指定位置直接生成一个某类对象，不受生成间隔限制。
+	 * @return 这类对象的数量已达上限时返回 false。
+	 */
+	bool world_spawn(GameWorld* world, const ObjectType type, const int x, const int y, const int vx, const int vy);
+
+	/**
+	 * @brief 在指定位置直接生成一架敌机，不受生成间隔限制。
+	 * @return 敌机数量已达上限时返回 false。
+	 */
+	bool world_spawn_enemy(GameWorld* world, const int x, const int y);
+
+	/**
+	 * @brief 在指定位置直接生成一颗子弹，不受开火间隔限制。
+	 * @return 子弹数量已达上限时返回 false。
+	 */
+	bool world_spawn_bullet(GameWorld* world, const int x, const int y);
+
+	/**
+	 * @brief 下一个 tick 按下开火键时能否真正开火，即距上次开火是否已经过了 min_fire_gap。
+	 */
+	bool world_can_fire(const GameWorld* world);
+
+	/**
+	 * @brief 按照本 tick 的输入位掩码推进一个 tick：移动、开火、生成敌机、两轮碰撞判断。
+	 *        任务调度器已启动时，移动、网格重建与子弹的碰撞判断分块并行执行，结果与串行执行逐位一致。
+	 */
+	void world_step(GameWorld* world, const unsigned input);
+
+	/**
+	 * @brief 各对象池中同时存活的对象总数，不含玩家。
+	 */
+	size_t world_object_count(const GameWorld* world);
+
+	/**
+	 * @brief 计算模拟状态的哈希值（FNV-1a），覆盖 tick 数、随机数状态、得分、生命值与所有对象的位置。
+	 *        两次模拟的哈希值相同即可认为结果逐位一致，用于录像回放的回归测试。
+	 */
+	uint64_t world_hash(const GameWorld* world);
+
+	/**
+	 * @brief 释放一局游戏的模拟状态。
+	 */
+	void world_free(GameWorld* world);
+
+#endif /* WORLD_H */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */